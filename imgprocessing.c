@@ -2,7 +2,7 @@
  * @Name : imgprocessing.c
  * @Description : Image Processing in C
  * @Date : 2023. 9. 12
- * @Revision : 0.7
+ * @Revision : 2.4
  * 0.1 : inverse
  * 0.2 : brightness, contrast
  * 0.3 : histogram, gonzales method, binalization
@@ -10,14 +10,240 @@
  * 0.5 : convolution(9~17)
  * 0.6 : laplacian high pass filter
  * 0.7 : Median Filter - MinPooling , MedianPooing, MaxPooling using Bubble Sorting, swap
+ * 0.8 : Large Kernel Convolution - Direct / FFT(overlap-add) 자동 선택
+ * 0.9 : Canny Edge Detection - 스트리밍 NMS, 자동 임계값, Stack 기반 Hysteresis
+ * 1.0 : 1bpp Packed / RLE8 Binarization 출력
+ * 1.1 : 다중 스레드 행 띠 처리, Connected Component Labeling 및 Blob 통계
+ * 1.2 : Strided Pooling(2x2, 3x3 Min/Max/Mean/Median), Gaussian Pyramid Reduce/Expand
+ * 1.3 : Resize - Nearest, Bilinear, Area (고정소수점 계수 표, 다중 스레드)
+ * 1.4 : Stage별 계측(ENABLE_PROFILE, Prometheus text 출력), 연산 중 printf 제거
+ * 1.5 : Daemon 모드 - Named Pipe 요청, 공유 메모리 슬롯 제자리 처리, 상주 작업 스레드
+ * 1.6 : 연산 결과 Cache (XXH64 키, blob 파일 Mapping, LRU 크기 상한, 적중 통계)
+ * 1.7 : ROI 처리 (사각형 목록 + Mask, 이웃 연산 halo, 필요한 행만 파일에서 읽기)
+ * 1.8 : Template Matching (SSD, Zero-mean NCC, 적분 영상, FFT 상관, Coarse-to-fine, 상위 K개)
+ * 1.9 : Bilateral Filter (공간 가중치 표, 범위 가중치 LUT, 큰 반경은 Bilateral Grid)
+ * 2.0 : 일괄 비동기 파일 입출력 (I/O Completion Port, 고정 정렬 버퍼, NO_BUFFERING, 파일당 읽기/쓰기 1회)
+ * 2.1 : NUMA / Large Page Frame 할당 (병렬 first-touch, IMGPROC_PIN_THREADS 스레드 Node 고정)
+ * 2.2 : 읽기 시점 영상 통계 (띠별 히스토그램/최소/최대/합/제곱합, 읽기와 같은 패스, 바뀐 띠만 다시 계산)
+ * 2.3 : 최적화 변형 차등 검증 (기준 Scalar 함수와 무작위 크기/패턴/정렬 비교, 변형별 속도 향상)
+ * 2.4 : Euclidean Distance Transform (Felzenszwalb-Huttenlocher, 열/행 띠 병렬, WORD/float 출력), 원판 팽창/침식
  * @Author : Howoong Lee, Division of Computer Enginnering, Hoseo Univ.
  */
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <math.h>
 #include <Windows.h>
 #include "convolution.h""
 
+#define FFT_PI 3.14159265358979323846
+
+// SSE2 사용 가능 여부 (x86 / x64)
+#if defined(_M_IX86) || defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define USE_SSE2
+#endif
+
+/*
+ * ver 1.4 : 계측(Profile)과 진단 기록
+ * ENABLE_PROFILE 을 정의하여 컴파일할 때만 계측 코드가 포함되며, 정의하지 않으면 PROFILE_* 매크로는 빈 문장
+ * 각 함수 진입점에서 TSC cycle, 처리 픽셀 수, 읽기/쓰기 바이트 수, 작업 스레드 이용률을 Stage별로 누적
+ * Windows에는 perf_event가 없으므로 스레드 CPU cycle(QueryThreadCycleTime)로 이용률을 계산
+ */
+#ifdef ENABLE_PROFILE
+#include <intrin.h>
+
+#define PROFILE_MAX_STAGES	64
+
+// Stage(함수)별 누적 계측 값
+typedef struct {
+	const char* Name;
+	ULONGLONG ullCalls;
+	ULONGLONG ullCycles;			// 경과 TSC cycle
+	ULONGLONG ullPixels;			// 처리 픽셀 수
+	ULONGLONG ullBytesRead;
+	ULONGLONG ullBytesWritten;
+	ULONGLONG ullThreadCycles;		// 작업 스레드 CPU cycle 합
+	ULONGLONG ullThreadSlots;		// 띠 수 x 경과 TSC cycle (이용률의 분모)
+} PROFILE_STAGE;
+
+static PROFILE_STAGE g_ProfileStage[PROFILE_MAX_STAGES];
+static int g_nProfileStages = 0;
+static volatile LONGLONG g_llBandCycles = 0;		// RunBands 작업 스레드 CPU cycle 누적
+static volatile LONGLONG g_llBandSlots = 0;			// RunBands 띠 수 x 경과 cycle 누적
+static ULONGLONG g_ullProfileTsc = 0;				// TSC 주파수 계산 기준점
+static LARGE_INTEGER g_ProfileQpc;
+
+/*
+ * @Function Name : ProfileStartClock
+ * @Descriotion : TSC 주파수 계산 기준점 - 첫 PROFILE_BEGIN에서 TSC와 QueryPerformanceCounter를 같은 시점에 기록
+ * @Input :
+ * @Output : g_ullProfileTsc, g_ProfileQpc
+ */
+void ProfileStartClock(void)
+{
+	if (0 == g_ullProfileTsc) {
+		QueryPerformanceCounter(&g_ProfileQpc);
+		g_ullProfileTsc = __rdtsc();
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : ProfileRecord
+ * @Descriotion : Stage 이름(__FUNCTION__)으로 계측 값을 누적
+ * @Input : *Name, ullCycles, ullPixels, ullRead, ullWritten, llThreadCycles, llThreadSlots
+ * @Output : g_ProfileStage
+ */
+void ProfileRecord(const char* Name, ULONGLONG ullCycles, ULONGLONG ullPixels, ULONGLONG ullRead, ULONGLONG ullWritten, LONGLONG llThreadCycles, LONGLONG llThreadSlots)
+{
+	PROFILE_STAGE* pStage = NULL;
+
+	for (int i = 0; i < g_nProfileStages; i++) {
+		if (g_ProfileStage[i].Name == Name || 0 == strcmp(g_ProfileStage[i].Name, Name)) {
+			pStage = &g_ProfileStage[i];
+			break;
+		}
+	}
+
+	if (NULL == pStage) {
+		if (g_nProfileStages == PROFILE_MAX_STAGES)
+			return;
+		pStage = &g_ProfileStage[g_nProfileStages++];
+		memset(pStage, 0, sizeof(PROFILE_STAGE));
+		pStage->Name = Name;
+	}
+
+	pStage->ullCalls++;
+	pStage->ullCycles += ullCycles;
+	pStage->ullPixels += ullPixels;
+	pStage->ullBytesRead += ullRead;
+	pStage->ullBytesWritten += ullWritten;
+	pStage->ullThreadCycles += (ULONGLONG)llThreadCycles;
+	pStage->ullThreadSlots += (ULONGLONG)llThreadSlots;
+
+	return;
+}
+
+/*
+ * @Function Name : ProfileDump
+ * @Descriotion : 누적된 계측 값을 Prometheus text 형식으로 출력 (TSC 주파수는 QueryPerformanceCounter로 환산)
+ * @Input : *fp
+ * @Output :
+ */
+void ProfileDump(FILE* fp)
+{
+	LARGE_INTEGER Now, Freq;
+	double dTscHz = 0.0;
+
+	QueryPerformanceCounter(&Now);
+	QueryPerformanceFrequency(&Freq);
+	if (Now.QuadPart > g_ProfileQpc.QuadPart)
+		dTscHz = (double)(__rdtsc() - g_ullProfileTsc) * Freq.QuadPart / (double)(Now.QuadPart - g_ProfileQpc.QuadPart);
+
+	fprintf(fp, "# HELP imgproc_stage_calls_total Number of calls per stage.\n# TYPE imgproc_stage_calls_total counter\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_calls_total{stage=\"%s\"} %llu\n", g_ProfileStage[i].Name, g_ProfileStage[i].ullCalls);
+
+	fprintf(fp, "# HELP imgproc_stage_cycles_total Elapsed TSC cycles per stage.\n# TYPE imgproc_stage_cycles_total counter\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_cycles_total{stage=\"%s\"} %llu\n", g_ProfileStage[i].Name, g_ProfileStage[i].ullCycles);
+
+	fprintf(fp, "# HELP imgproc_stage_seconds_total Wall time per stage.\n# TYPE imgproc_stage_seconds_total counter\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_seconds_total{stage=\"%s\"} %.9f\n", g_ProfileStage[i].Name,
+			dTscHz > 0.0 ? g_ProfileStage[i].ullCycles / dTscHz : 0.0);
+
+	fprintf(fp, "# HELP imgproc_stage_pixels_total Pixels processed per stage.\n# TYPE imgproc_stage_pixels_total counter\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_pixels_total{stage=\"%s\"} %llu\n", g_ProfileStage[i].Name, g_ProfileStage[i].ullPixels);
+
+	fprintf(fp, "# HELP imgproc_stage_bytes_read_total Bytes read per stage.\n# TYPE imgproc_stage_bytes_read_total counter\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_bytes_read_total{stage=\"%s\"} %llu\n", g_ProfileStage[i].Name, g_ProfileStage[i].ullBytesRead);
+
+	fprintf(fp, "# HELP imgproc_stage_bytes_written_total Bytes written per stage.\n# TYPE imgproc_stage_bytes_written_total counter\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_bytes_written_total{stage=\"%s\"} %llu\n", g_ProfileStage[i].Name, g_ProfileStage[i].ullBytesWritten);
+
+	fprintf(fp, "# HELP imgproc_stage_thread_utilization Worker CPU cycles / (bands x elapsed cycles), 1 if single-threaded.\n# TYPE imgproc_stage_thread_utilization gauge\n");
+	for (int i = 0; i < g_nProfileStages; i++)
+		fprintf(fp, "imgproc_stage_thread_utilization{stage=\"%s\"} %.4f\n", g_ProfileStage[i].Name,
+			g_ProfileStage[i].ullThreadSlots > 0 ? (double)g_ProfileStage[i].ullThreadCycles / g_ProfileStage[i].ullThreadSlots : 1.0);
+
+	return;
+}
+
+#define PROFILE_BEGIN() \
+	ProfileStartClock(); \
+	ULONGLONG ullProfileStart = __rdtsc(); \
+	LONGLONG llProfileBandCycles = g_llBandCycles, llProfileBandSlots = g_llBandSlots
+
+#define PROFILE_END(Pixels, BytesRead, BytesWritten) \
+	ProfileRecord(__FUNCTION__, __rdtsc() - ullProfileStart, (ULONGLONG)(Pixels), (ULONGLONG)(BytesRead), (ULONGLONG)(BytesWritten), \
+		g_llBandCycles - llProfileBandCycles, g_llBandSlots - llProfileBandSlots)
+
+#else
+#define PROFILE_BEGIN()
+#define PROFILE_END(Pixels, BytesRead, BytesWritten)
+#endif
+
+// 연산 함수 안에서 printf 하지 않고 값만 기록해 두었다가 main에서 출력
+#define DIAG_MAX_RECORDS	64
+
+typedef struct {
+	const char* Name;
+	int nValue;
+} DIAG_RECORD;
+
+static DIAG_RECORD g_DiagRecord[DIAG_MAX_RECORDS];
+static int g_nDiagRecords = 0;
+static int g_nDiagDropped = 0;
+
+/*
+ * @Function Name : DiagRecord
+ * @Descriotion : 진단 값 기록 (가득 차면 버린 개수만 증가)
+ * @Input : *Name, nValue
+ * @Output : g_DiagRecord
+ */
+void DiagRecord(const char* Name, int nValue)
+{
+	if (g_nDiagRecords == DIAG_MAX_RECORDS) {
+		g_nDiagDropped++;
+		return;
+	}
+
+	g_DiagRecord[g_nDiagRecords].Name = Name;
+	g_DiagRecord[g_nDiagRecords].nValue = nValue;
+	g_nDiagRecords++;
+
+	return;
+}
+
+/*
+ * @Function Name : FlushDiag
+ * @Descriotion : 기록된 진단 값을 화면에 출력하고 비움
+ * @Input :
+ * @Output :
+ */
+void FlushDiag(void)
+{
+	if (0 == g_nDiagRecords)
+		return;
+
+	printf("---------------------------\n");
+	for (int i = 0; i < g_nDiagRecords; i++)
+		printf("%s = %d\n", g_DiagRecord[i].Name, g_DiagRecord[i].nValue);
+	if (g_nDiagDropped > 0)
+		printf("(%d records dropped)\n", g_nDiagDropped);
+
+	g_nDiagRecords = 0;
+	g_nDiagDropped = 0;
+
+	return;
+}
+
  /*
   * @Function Name : InverseImage
   * @Descriotion : Pixel 단위로 밝기값을 Inverse
@@ -26,12 +252,16 @@
   */
 void InverseImage(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	int nImgSize = nWidth * nHeight;
 
 	// convert
 	for (int i = 0; i < nImgSize; i++)
 		Output[i] = 255 - Input[i];
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 
 }
@@ -44,6 +274,8 @@ void InverseImage(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void AdjustBrightness(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nBrightness)
 {
+	PROFILE_BEGIN();
+
 	int nImgSize = nWidth * nHeight;
 
 	for (int i = 0; i < nImgSize; i++)
@@ -54,6 +286,8 @@ void AdjustBrightness(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nB
 		else
 			Output[i] = Input[i] + nBrightness;
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -65,6 +299,8 @@ void AdjustBrightness(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nB
  */
 void AdjustContrast(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double dContrast)
 {
+	PROFILE_BEGIN();
+
 	int nImgSize = nWidth * nHeight;
 
 	for (int i = 0; i < nImgSize; i++)
@@ -73,6 +309,8 @@ void AdjustContrast(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double d
 		else
 			Output[i] = (BYTE)(Input[i] * dContrast);
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -84,11 +322,15 @@ void AdjustContrast(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double d
  */
 void GenerateHistogram(BYTE* Input, int* Histogram, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	int nImgSize = nWidth * nHeight;
 
 	for (int i = 0; i < nImgSize; i++)
 		Histogram[Input[i]]++;
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, sizeof(int) * 256);
+
 	return;
 }
 
@@ -100,6 +342,8 @@ void GenerateHistogram(BYTE* Input, int* Histogram, int nWidth, int nHeight)
  */
 void GenerateBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, BYTE bThreshold)
 {
+	PROFILE_BEGIN();
+
 	int nImgSize = nWidth * nHeight;
 
 	for (int i = 0; i < nImgSize; i++)
@@ -108,44 +352,27 @@ void GenerateBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, BY
 		else
 			Output[i] = 255;
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
 /*
- * @Function Name : GonzalezMethod
- * @Descriotion : Gonzalez, Wodds Method에 따라 최적의 이진화 임계값을 계산
- * @Input : *Histogram
+ * @Function Name : GonzalezMethodRange
+ * @Descriotion : Gonzalez, Wodds Method에 따라 최적의 이진화 임계값을 계산 (영상 최소/최대 밝기를 이미 알고 있는 경우)
+ * @Input : *Histogram, bLow(최소 밝기), bHigh(최대 밝기)
  * @Output : bThreshold
  */
-BYTE GonzalezMethod(int* Histogram)
+BYTE GonzalezMethodRange(int* Histogram, BYTE bLow, BYTE bHigh)
 {
-
-	BYTE bLow = 0, bHigh = 0;
 	BYTE bThreshold, bNewThreshold;
 	BYTE e = 2; // 오차값 설정
 
 	int nG1 = 0, nG2 = 0, nCntG1 = 0, nCntG2 = 0, nMeanG1, nMeanG2;
 
-	// 초기 Threshold를 영상에서 어두운 값으로 설정
-	for (int i = 0; i < 256; i++) {
-		if (Histogram[i] != 0) {
-			bLow = i;
-			break;
-		}
-	}
-
-	// 초기 Threshold를 영상에서 가장 밝은 값
-	for (int i = 255; i >= 0; i--) {
-		if (Histogram[i] != 0) {
-			bHigh = i;
-			break;
-		}
-	}
-
 	// 1. Threshold의 초기값을 추정: 최소값 + 최대값 / 2
 	bThreshold = (bLow + bHigh) / 2;
-	printf("---------------------------\n");
-	printf("Initial Threshold = %d\n", bThreshold);
+	DiagRecord("Initial Threshold", bThreshold);
 
 
 	// 2~4번을 e보다 작을때까지 반복 : e = 2로 설정
@@ -184,7 +411,7 @@ BYTE GonzalezMethod(int* Histogram)
 		}
 		else {
 			bThreshold = bNewThreshold;
-			printf("New Threshold = %d\n", bNewThreshold);
+			DiagRecord("New Threshold", bNewThreshold);
 
 		}
 
@@ -192,37 +419,51 @@ BYTE GonzalezMethod(int* Histogram)
 		nG1 = nG2 = nCntG1 = nCntG2 = 0;
 	}
 
-	printf("Last Threshold = %d\n", bThreshold);
+	DiagRecord("Last Threshold", bThreshold);
 	return bThreshold;
 }
 
 /*
- * @Function Name : HistogramStretching
- * @Descriotion : 히스토그램 스트래칭을 수행
- * @Input : *Input, *Histigrnam, nWidth, nHeight
- * @Output : *Output
+ * @Function Name : GonzalezMethod
+ * @Descriotion : Gonzalez, Wodds Method에 따라 최적의 이진화 임계값을 계산
+ * @Input : *Histogram
+ * @Output : bThreshold
  */
-void HistogramStretching(BYTE* Input, BYTE* Output, int* Histogram, int nWidth, int nHeight)
+BYTE GonzalezMethod(int* Histogram)
 {
-	int ImgSize = nWidth * nHeight;
-	BYTE Low, High;
+	BYTE bLow = 0, bHigh = 0;
 
-	// 히스토그램에서 최초로 0이 아닌 밝기 값을 계산
+	// 초기 Threshold를 영상에서 어두운 값으로 설정
 	for (int i = 0; i < 256; i++) {
 		if (Histogram[i] != 0) {
-			Low = i;
+			bLow = i;
 			break;
 		}
 	}
 
-	// 히스토그램에서 마지막으로 0이 아닌 밝기 값을 계산
+	// 초기 Threshold를 영상에서 가장 밝은 값
 	for (int i = 255; i >= 0; i--) {
 		if (Histogram[i] != 0) {
-			High = i;
+			bHigh = i;
 			break;
 		}
 	}
 
+	return GonzalezMethodRange(Histogram, bLow, bHigh);
+}
+
+/*
+ * @Function Name : HistogramStretchingRange
+ * @Descriotion : 히스토그램 스트래칭을 수행 (영상 최소/최대 밝기를 이미 알고 있는 경우)
+ * @Input : *Input, Low(최소 밝기), High(최대 밝기), nWidth, nHeight
+ * @Output : *Output
+ */
+void HistogramStretchingRange(BYTE* Input, BYTE* Output, BYTE Low, BYTE High, int nWidth, int nHeight)
+{
+	PROFILE_BEGIN();
+
+	int ImgSize = nWidth * nHeight;
+
 	// 스트래칭 수행
 	for (int i = 0; i < ImgSize; i++) {
 		// Input[i] - Low = 밝기의 최소값이 0이 되도록 설정
@@ -236,6 +477,39 @@ void HistogramStretching(BYTE* Input, BYTE* Output, int* Histogram, int nWidth,
 		}		 
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
+	return;
+}
+
+/*
+ * @Function Name : HistogramStretching
+ * @Descriotion : 히스토그램 스트래칭을 수행
+ * @Input : *Input, *Histigrnam, nWidth, nHeight
+ * @Output : *Output
+ */
+void HistogramStretching(BYTE* Input, BYTE* Output, int* Histogram, int nWidth, int nHeight)
+{
+	BYTE Low, High;
+
+	// 히스토그램에서 최초로 0이 아닌 밝기 값을 계산
+	for (int i = 0; i < 256; i++) {
+		if (Histogram[i] != 0) {
+			Low = i;
+			break;
+		}
+	}
+
+	// 히스토그램에서 마지막으로 0이 아닌 밝기 값을 계산
+	for (int i = 255; i >= 0; i--) {
+		if (Histogram[i] != 0) {
+			High = i;
+			break;
+		}
+	}
+
+	HistogramStretchingRange(Input, Output, Low, High, nWidth, nHeight);
+
 	return;
 }
 
@@ -247,6 +521,8 @@ void HistogramStretching(BYTE* Input, BYTE* Output, int* Histogram, int nWidth,
  */
 void HistogramEqualization(BYTE* Input, BYTE* Output, int* Histogram, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	int ImgSize = nWidth * nHeight;
 
 	int Nt = ImgSize;	// 총 픽셀수로 이미지 크기와 같음
@@ -276,6 +552,8 @@ void HistogramEqualization(BYTE* Input, BYTE* Output, int* Histogram, int nWidth
 		Output[i] = NormSum[Input[i]];
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -287,6 +565,8 @@ void HistogramEqualization(BYTE* Input, BYTE* Output, int* Histogram, int nWidth
  */
 void AverageConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -302,6 +582,8 @@ void AverageConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -313,6 +595,8 @@ void AverageConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void GaussianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -328,6 +612,8 @@ void GaussianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -339,6 +625,8 @@ void GaussianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void LaplacianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -356,6 +644,8 @@ void LaplacianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -367,6 +657,8 @@ void LaplacianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void X_PrewittConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -384,6 +676,8 @@ void X_PrewittConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -395,6 +689,8 @@ void X_PrewittConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void Y_PrewittConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -412,6 +708,8 @@ void Y_PrewittConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -423,6 +721,8 @@ void Y_PrewittConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void X_SobelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -440,6 +740,8 @@ void X_SobelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -451,6 +753,8 @@ void X_SobelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void Y_SobelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -468,6 +772,8 @@ void Y_SobelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -479,6 +785,8 @@ void Y_SobelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
  */
 void HPF_LaplacianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	double SumProduct = 0.0;
 
 	// Convolution Center를 (1,1)로 잡기 위해 1부터 시작, n-1까지 진행
@@ -502,6 +810,8 @@ void HPF_LaplacianConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
@@ -546,7 +856,7 @@ BYTE MinPooling(BYTE* bArr, int nSize)
  * @Function Name : MedianPooling
  * @Descriotion : 
  * @Input : *bArr, nSize
- * @Output : *bArr[4]
+ * @Output : *bArr[nSize / 2]
  */
 BYTE MedianPooling(BYTE* bArr, int nSize)
 {
@@ -560,14 +870,14 @@ BYTE MedianPooling(BYTE* bArr, int nSize)
 		}
 	}
 
-	return bArr[4];
+	return bArr[nSize / 2];
 }
 
 /*
  * @Function Name : MaxPooling
  * @Descriotion : 
  * @Input : *bArr, nSize
- * @Output : bArr[8]
+ * @Output : bArr[nSize - 1]
  */
 BYTE MaxPooling(BYTE* bArr, int nSize)
 {
@@ -581,7 +891,7 @@ BYTE MaxPooling(BYTE* bArr, int nSize)
 		}
 	}
 
-	return bArr[8];
+	return bArr[nSize - 1];
 }
 
 /*
@@ -592,6 +902,8 @@ BYTE MaxPooling(BYTE* bArr, int nSize)
  */
 void MedianFilter(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 {
+	PROFILE_BEGIN();
+
 	BYTE temp[9];
 	int i, j = 1;
 
@@ -611,83 +923,7316 @@ void MedianFilter(BYTE* Input, BYTE* Output, int nWidth, int nHeight)
 		}
 	}
 
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
 	return;
 }
 
 
 /*
- * @Function Name : main
- * @Descriotion : Image Processing main 함수로 switch 문에 따라 함수를 호출하여 기능을 수행
- * @Input :
- * @Output :
+ * ver 0.8 : Large Kernel Convolution
+ * 3x3 고정 Kernel이 아닌 nKSize x nKSize Kernel(31x31 이상의 deblur, matched filter 등)을 위한 Convolution
+ * 직접(공간) 방식은 픽셀당 O(k^2), FFT 방식은 overlap-add tiling으로 메모리를 (N x 폭) 정도로 제한
  */
-void main()
-{
-	// BMT Header 구조체 선언
-	BITMAPFILEHEADER hf; // BMP 파일헤더 14Bytes
-	BITMAPINFOHEADER hInfo; // BMP 인포헤더 40Bytes
-	RGBQUAD hRGB[256] = { 0, };// 파레트 (256 * 4Bytes)
-
-	// 변수 선언
-	FILE* fp = NULL;				// 파일 포인터
-	errno_t nErr = 0;				// Error	
-	int nImgSize = 0;				// 이미지 크기
 
-	// ver 0.2 변수 추가
-	int nBrigntness = 0;	// 밝기 값
-	double dContrast = 0;		// 대비 값
+// 복소수 (MSVC는 C99 _Complex를 지원하지 않으므로 구조체로 정의)
+typedef struct {
+	double re;
+	double im;
+} COMPLEX;
 
-	// ver 0.3 변수 추가
-	int nHisto[256] = { 0, };
-	BYTE bThreshold;
-	int nThreshold = 0;			// threshold를 입력
+// FFT Convolution에 필요한 버퍼와 회전 인자(Twiddle)를 묶어서 관리
+typedef struct {
+	int nSize;				// 2D FFT 크기 N (N x N, 2의 거듭제곱)
+	int nHalf;				// N / 2 (실수 FFT를 N/2 길이 복소 FFT로 계산)
+	COMPLEX* Twiddle;		// e^(-2πik/N), k = 0 ~ N/2-1
+	COMPLEX* Spectrum;		// N x (N/2 + 1) 주파수 영역 작업 버퍼
+	COMPLEX* Line;			// 행/열 1차원 FFT 작업 버퍼 (N)
+} FFT_PLAN;
 
-	int nMode = 0;					// 기능 선택
-	CHAR PATH[256] = { 0, };		// 파일 경로
+static double g_dDirectCost = 0.0;		// 직접 방식 : 곱셈-누적 1회당 측정 시간(초)
+static double g_dFFTCost = 0.0;			// FFT 방식 : N*N*log2(N) 1단위당 측정 시간(초)
 
-	// 사용자 입력
-	printf("=================================\n\n");
-	printf("Image Processing Program\n\n");
-	printf("1.  Inverse Image\n");
-	printf("2.  Adjust Brightness\n");
-	printf("3.  Adjust Contrast\n");
-	printf("4.  Generate Histogram\n");
-	printf("5.  Generate Binarization - Gonzalez Method\n");
-	printf("6.  Generate Binarization\n");
-	printf("7.  Histogram Stretching\n");
-	printf("8.  Histogram Equalization\n");
-	printf("9.  Average Convolution\n");
-	printf("10. Gaussian Convolution\n");
-	printf("11. Laplacian Convolution\n");
-	printf("12. Prewitt X Convolution\n");
-	printf("13. Prewitt Y Convolution\n");
-	printf("14. Prewitt Convolution\n");
-	printf("15. Sobel X Convolution\n");
-	printf("16. Sobel Y Convolution\n");
-	printf("17. Sobel Convolution\n");
-	printf("18. Laplacian High Pass Filter Convolution\n");
-	printf("19. Meadian Filter, Min Pooling, Min Pooling, Max Pooling\n\n");
-	printf("=================================\n\n");
+/*
+ * @Function Name : FFT1D
+ * @Descriotion : Radix-2 Cooley-Tukey 1차원 복소수 FFT (in-place), nDir = 1 정방향, -1 역방향(정규화 없음)
+ *                nLength는 Plan 크기 N 이하의 2의 거듭제곱
+ * @Input : *Data, nLength, *Plan, nDir
+ * @Output : *Data
+ */
+void FFT1D(COMPLEX* Data, int nLength, FFT_PLAN* Plan, int nDir)
+{
+	COMPLEX temp, u, v, w;
+
+	// 비트 반전 순서로 재배치
+	for (int i = 1, j = 0; i < nLength; i++) {
+		int bit = nLength >> 1;
+		for (; j & bit; bit >>= 1)
+			j ^= bit;
+		j ^= bit;
+
+		if (i < j) {
+			temp = Data[i];
+			Data[i] = Data[j];
+			Data[j] = temp;
+		}
+	}
 
-	printf("원하는 기능의 번호를 입력하세요 : ");
-	scanf_s("%d", &nMode);
+	// Butterfly 연산 : 길이 len 단계의 회전 인자는 Twiddle[k * (N / len)]
+	for (int len = 2; len <= nLength; len <<= 1) {
+		int nHalfLen = len >> 1;
+		int nStep = Plan->nSize / len;
 
-	printf("원본 이미지 파일의 경로를 입력하세요 : ");
-	scanf_s("%s", PATH, sizeof(PATH));
+		for (int i = 0; i < nLength; i += len) {
+			for (int k = 0; k < nHalfLen; k++) {
+				w = Plan->Twiddle[k * nStep];
+				w.im *= nDir;		// 역방향은 켤레 복소수
 
-	// 이미지 파일 오픈
-	nErr = fopen_s(&fp, PATH, "rb");
+				u = Data[i + k];
+				v.re = Data[i + k + nHalfLen].re * w.re - Data[i + k + nHalfLen].im * w.im;
+				v.im = Data[i + k + nHalfLen].re * w.im + Data[i + k + nHalfLen].im * w.re;
 
-	if (NULL == fp) {
-		printf("Error : file open error = %d\n", nErr);
-		return;
+				Data[i + k].re = u.re + v.re;
+				Data[i + k].im = u.im + v.im;
+				Data[i + k + nHalfLen].re = u.re - v.re;
+				Data[i + k + nHalfLen].im = u.im - v.im;
+			}
+		}
 	}
 
-	// BITMAPFILEHEADER
-	fread(&hf, sizeof(BITMAPFILEHEADER), 1, fp);
+	return;
+}
 
-	// BITMAPINFOHEADER
-	fread(&hInfo, sizeof(BITMAPINFOHEADER), 1, fp);
+/*
+ * @Function Name : RealFFT
+ * @Descriotion : 길이 N 실수 신호의 FFT, 짝/홀 샘플을 N/2 길이 복소수로 묶어 한 번의 복소 FFT로 계산
+ *                X[k], k = 0 ~ N/2 만 출력 (나머지는 켤레 대칭)
+ * @Input : *Real, *Plan
+ * @Output : *Spectrum
+ */
+void RealFFT(double* Real, COMPLEX* Spectrum, FFT_PLAN* Plan)
+{
+	int M = Plan->nHalf;
+	COMPLEX* Z = Plan->Line;
+	COMPLEX A, B, Fe, Fo, W;
+
+	// z[n] = x[2n] + i x[2n+1]
+	for (int n = 0; n < M; n++) {
+		Z[n].re = Real[2 * n];
+		Z[n].im = Real[2 * n + 1];
+	}
+
+	FFT1D(Z, M, Plan, 1);
+
+	// 분리 단계 : Fe = (Z[k] + conj(Z[M-k])) / 2, Fo = -i (Z[k] - conj(Z[M-k])) / 2, X[k] = Fe + W^k Fo
+	for (int k = 0; k < M; k++) {
+		A = Z[k];
+		B = Z[(M - k) % M];
+
+		Fe.re = (A.re + B.re) * 0.5;
+		Fe.im = (A.im - B.im) * 0.5;
+		Fo.re = (A.im + B.im) * 0.5;
+		Fo.im = -(A.re - B.re) * 0.5;
+
+		W = Plan->Twiddle[k];
+		Spectrum[k].re = Fe.re + W.re * Fo.re - W.im * Fo.im;
+		Spectrum[k].im = Fe.im + W.re * Fo.im + W.im * Fo.re;
+
+		if (0 == k) {
+			// W^M = -1
+			Spectrum[M].re = Fe.re - Fo.re;
+			Spectrum[M].im = 0.0;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : InverseRealFFT
+ * @Descriotion : RealFFT의 역변환, X[k] (k = 0 ~ N/2)로부터 길이 N 실수 신호 복원 (1/(N/2) 정규화 없음)
+ * @Input : *Spectrum, *Plan
+ * @Output : *Real
+ */
+void InverseRealFFT(COMPLEX* Spectrum, double* Real, FFT_PLAN* Plan)
+{
+	int M = Plan->nHalf;
+	COMPLEX* Z = Plan->Line;
+	COMPLEX A, B, Fe, Fo, D, W;
+
+	// Fe = (X[k] + conj(X[M-k])) / 2, Fo = (X[k] - conj(X[M-k])) conj(W^k) / 2, Z[k] = Fe + i Fo
+	for (int k = 0; k < M; k++) {
+		A = Spectrum[k];
+		B = Spectrum[M - k];
+
+		Fe.re = (A.re + B.re) * 0.5;
+		Fe.im = (A.im - B.im) * 0.5;
+		D.re = (A.re - B.re) * 0.5;
+		D.im = (A.im + B.im) * 0.5;
+
+		W = Plan->Twiddle[k];
+		Fo.re = D.re * W.re + D.im * W.im;
+		Fo.im = D.im * W.re - D.re * W.im;
+
+		Z[k].re = Fe.re - Fo.im;
+		Z[k].im = Fe.im + Fo.re;
+	}
+
+	FFT1D(Z, M, Plan, -1);
+
+	for (int n = 0; n < M; n++) {
+		Real[2 * n] = Z[n].re;
+		Real[2 * n + 1] = Z[n].im;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : FFT2D
+ * @Descriotion : N x N 실수 영상의 2차원 FFT (행 : 실수 FFT, 열 : 복소 FFT), 출력은 N x (N/2 + 1)
+ *                nValidRows 이후의 행은 0으로 간주하여 행 FFT를 생략
+ * @Input : *Real, nValidRows, *Plan
+ * @Output : *Spectrum
+ */
+void FFT2D(double* Real, int nValidRows, COMPLEX* Spectrum, FFT_PLAN* Plan)
+{
+	int N = Plan->nSize;
+	int nCols = Plan->nHalf + 1;
+
+	for (int y = 0; y < N; y++) {
+		if (y < nValidRows)
+			RealFFT(&Real[y * N], &Spectrum[y * nCols], Plan);
+		else
+			memset(&Spectrum[y * nCols], 0, sizeof(COMPLEX) * nCols);
+	}
+
+	for (int x = 0; x < nCols; x++) {
+		for (int y = 0; y < N; y++)
+			Plan->Line[y] = Spectrum[y * nCols + x];
+
+		FFT1D(Plan->Line, N, Plan, 1);
+
+		for (int y = 0; y < N; y++)
+			Spectrum[y * nCols + x] = Plan->Line[y];
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : InverseFFT2D
+ * @Descriotion : FFT2D의 역변환 (정규화 없음, 정규화는 Kernel 스펙트럼에 미리 반영)
+ * @Input : *Spectrum, *Plan
+ * @Output : *Real
+ */
+void InverseFFT2D(COMPLEX* Spectrum, double* Real, FFT_PLAN* Plan)
+{
+	int N = Plan->nSize;
+	int nCols = Plan->nHalf + 1;
+
+	for (int x = 0; x < nCols; x++) {
+		for (int y = 0; y < N; y++)
+			Plan->Line[y] = Spectrum[y * nCols + x];
+
+		FFT1D(Plan->Line, N, Plan, -1);
+
+		for (int y = 0; y < N; y++)
+			Spectrum[y * nCols + x] = Plan->Line[y];
+	}
+
+	for (int y = 0; y < N; y++)
+		InverseRealFFT(&Spectrum[y * nCols], &Real[y * N], Plan);
+
+	return;
+}
+
+/*
+ * @Function Name : CreateFFTPlan
+ * @Descriotion : N x N FFT를 위한 회전 인자와 작업 버퍼를 할당
+ * @Input : *Plan, nSize
+ * @Output : 성공 1, 실패 0
+ */
+int CreateFFTPlan(FFT_PLAN* Plan, int nSize)
+{
+	Plan->nSize = nSize;
+	Plan->nHalf = nSize / 2;
+	Plan->Twiddle = (COMPLEX*)malloc(sizeof(COMPLEX) * Plan->nHalf);
+	Plan->Spectrum = (COMPLEX*)malloc(sizeof(COMPLEX) * nSize * (Plan->nHalf + 1));
+	Plan->Line = (COMPLEX*)malloc(sizeof(COMPLEX) * nSize);
+
+	if (NULL == Plan->Twiddle || NULL == Plan->Spectrum || NULL == Plan->Line) {
+		free(Plan->Twiddle);
+		free(Plan->Spectrum);
+		free(Plan->Line);
+		return 0;
+	}
+
+	for (int k = 0; k < Plan->nHalf; k++) {
+		Plan->Twiddle[k].re = cos(-2.0 * FFT_PI * k / nSize);
+		Plan->Twiddle[k].im = sin(-2.0 * FFT_PI * k / nSize);
+	}
+
+	return 1;
+}
+
+/*
+ * @Function Name : DestroyFFTPlan
+ * @Descriotion : CreateFFTPlan에서 할당한 버퍼 해제
+ * @Input : *Plan
+ * @Output :
+ */
+void DestroyFFTPlan(FFT_PLAN* Plan)
+{
+	free(Plan->Twiddle);
+	free(Plan->Spectrum);
+	free(Plan->Line);
+
+	return;
+}
+
+/*
+ * @Function Name : SelectFFTSize
+ * @Descriotion : Kernel 크기에 대해 출력 픽셀당 비용 N^2 log2(N) / (N - k + 1)^2 이 최소가 되는 FFT 크기 선택
+ * @Input : nKSize
+ * @Output : N (Kernel이 너무 커서 4096 이하 후보가 없으면 0)
+ */
+int SelectFFTSize(int nKSize)
+{
+	int nBest = 0;
+	double dBestCost = 0.0;
+	int N = 16;
+
+	while (N < 2 * nKSize)
+		N <<= 1;
+
+	// 2k 이상의 후보 3개 중 선택 (메모리 제한을 위해 4096 이하)
+	for (int i = 0; i < 3 && N <= 4096; i++, N <<= 1) {
+		int nLog2 = 0;
+		int T = N - nKSize + 1;
+		double dCost;
+
+		while ((1 << nLog2) < N)
+			nLog2++;
+
+		dCost = (double)N * N * nLog2 / ((double)T * T);
+		if (0 == nBest || dCost < dBestCost) {
+			nBest = N;
+			dBestCost = dCost;
+		}
+	}
+
+	return nBest;
+}
+
+/*
+ * @Function Name : DirectConvolution
+ * @Descriotion : nKSize x nKSize Kernel을 적용한 공간 영역 Convolution, 결과는 0 ~ 255로 조정
+ * @Input : *Input, nWidth, nHeight, *Kernel(행 우선 nKSize * nKSize), nKSize(홀수)
+ * @Output : *Output
+ */
+void DirectConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double* Kernel, int nKSize)
+{
+	int r = nKSize / 2;
+	double SumProduct = 0.0;
+
+	// Convolution Center를 (r,r)로 잡기 위해 r부터 시작, n-r까지 진행
+	for (int i = r; i < nHeight - r; i++) {			// y 행
+		for (int j = r; j < nWidth - r; j++) {		// x
+			for (int m = -r; m <= r; m++) {			// kernel의 행
+				BYTE* pRow = &Input[(i + m) * nWidth + j];
+				double* pKernel = &Kernel[(m + r) * nKSize + r];
+
+				for (int n = -r; n <= r; n++)		// kernel의 열
+					SumProduct += pRow[n] * pKernel[n];
+			}
+
+			// 255보다 크면 255로 조정, 0보다 작으면 0으로 조정
+			if (SumProduct > 255.0)
+				Output[i * nWidth + j] = 255;
+			else if (SumProduct < 0.0)
+				Output[i * nWidth + j] = 0;
+			else
+				Output[i * nWidth + j] = (BYTE)SumProduct;
+
+			SumProduct = 0.0;						// 초기화
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : FFTConvolution
+ * @Descriotion : Overlap-add 방식 FFT Convolution, DirectConvolution과 같은 결과(경계 r 픽셀 제외)
+ *                T x T 입력 타일을 N x N으로 0 패딩 -> FFT -> Kernel 스펙트럼 곱 -> 역 FFT -> 누적
+ *                누적 버퍼는 N 행 띠(strip)만 유지하고, 완성된 T 행씩 출력 후 위로 밀어 올림
+ * @Input : *Input, nWidth, nHeight, *Kernel, nKSize
+ * @Output : *Output, 성공 1, FFT 크기 없음 / 메모리 할당 실패 0
+ */
+int FFTConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double* Kernel, int nKSize)
+{
+	FFT_PLAN Plan;
+	int r = nKSize / 2;
+	int N = SelectFFTSize(nKSize);
+	int T = N - nKSize + 1;					// 타일 크기 (선형 Convolution 결과 T + k - 1 <= N)
+	int nCols = N / 2 + 1;
+	int nTilesX, nAccWidth;
+	double dScale;
+
+	// 선택할 FFT 크기가 없으면 호출자가 직접 방식으로 수행
+	if (N <= 0 || T <= 0)
+		return 0;
+
+	nTilesX = (nWidth + T - 1) / T;
+	nAccWidth = nTilesX * T + nKSize - 1;
+
+	if (0 == CreateFFTPlan(&Plan, N))
+		return 0;
+
+	double* Tile = (double*)malloc(sizeof(double) * N * N);
+	COMPLEX* KernelSpectrum = (COMPLEX*)malloc(sizeof(COMPLEX) * N * nCols);
+	double* Acc = (double*)calloc((size_t)N * nAccWidth, sizeof(double));
+
+	if (NULL == Tile || NULL == KernelSpectrum || NULL == Acc) {
+		free(Tile);
+		free(KernelSpectrum);
+		free(Acc);
+		DestroyFFTPlan(&Plan);
+		return 0;
+	}
+
+	// 기존 *Convolution 함수들과 같은 상관(correlation) 결과를 얻기 위해 Kernel을 180도 회전하여 배치
+	memset(Tile, 0, sizeof(double) * N * N);
+	for (int m = 0; m < nKSize; m++)
+		for (int n = 0; n < nKSize; n++)
+			Tile[m * N + n] = Kernel[(nKSize - 1 - m) * nKSize + (nKSize - 1 - n)];
+
+	FFT2D(Tile, nKSize, KernelSpectrum, &Plan);
+
+	// 역변환 정규화(열 N, 행 N/2)를 Kernel 스펙트럼에 미리 반영
+	dScale = 1.0 / ((double)N * Plan.nHalf);
+	for (int i = 0; i < N * nCols; i++) {
+		KernelSpectrum[i].re *= dScale;
+		KernelSpectrum[i].im *= dScale;
+	}
+
+	for (int ty = 0; ty < nHeight; ty += T) {
+		int nRows = (nHeight - ty < T) ? nHeight - ty : T;
+
+		for (int tx = 0; tx < nWidth; tx += T) {
+			int nTileCols = (nWidth - tx < T) ? nWidth - tx : T;
+
+			// 입력 타일을 0 패딩하여 복사
+			memset(Tile, 0, sizeof(double) * N * N);
+			for (int y = 0; y < nRows; y++)
+				for (int x = 0; x < nTileCols; x++)
+					Tile[y * N + x] = Input[(ty + y) * nWidth + tx + x];
+
+			FFT2D(Tile, nRows, Plan.Spectrum, &Plan);
+
+			// 주파수 영역에서 곱셈
+			for (int i = 0; i < N * nCols; i++) {
+				COMPLEX a = Plan.Spectrum[i];
+				COMPLEX b = KernelSpectrum[i];
+
+				Plan.Spectrum[i].re = a.re * b.re - a.im * b.im;
+				Plan.Spectrum[i].im = a.re * b.im + a.im * b.re;
+			}
+
+			InverseFFT2D(Plan.Spectrum, Tile, &Plan);
+
+			// 타일 결과 (nRows + k - 1) x (nTileCols + k - 1)를 누적
+			for (int y = 0; y < nRows + nKSize - 1; y++)
+				for (int x = 0; x < nTileCols + nKSize - 1; x++)
+					Acc[y * nAccWidth + tx + x] += Tile[y * N + x];
+		}
+
+		// 누적 버퍼의 y 행 = full Convolution의 (ty + y) 행 = 출력 영상의 (ty + y - r) 행
+		for (int y = 0; y < nRows; y++) {
+			int i = ty + y - r;
+
+			if (i < r || i >= nHeight - r)
+				continue;
+
+			for (int j = r; j < nWidth - r; j++) {
+				double SumProduct = Acc[y * nAccWidth + j + r];
+
+				if (SumProduct > 255.0)
+					Output[i * nWidth + j] = 255;
+				else if (SumProduct < 0.0)
+					Output[i * nWidth + j] = 0;
+				else
+					Output[i * nWidth + j] = (BYTE)(SumProduct + 1e-9);	// 부동소수 오차 보정
+			}
+		}
+
+		// 다음 타일 행과 겹치는 k - 1 행을 위로 이동, 나머지는 0으로 초기화
+		memmove(Acc, &Acc[T * nAccWidth], sizeof(double) * (nKSize - 1) * nAccWidth);
+		memset(&Acc[(nKSize - 1) * nAccWidth], 0, sizeof(double) * (N - nKSize + 1) * nAccWidth);
+	}
+
+	free(Tile);
+	free(KernelSpectrum);
+	free(Acc);
+	DestroyFFTPlan(&Plan);
+
+	return 1;
+}
+
+/*
+ * @Function Name : GetElapsedTime
+ * @Descriotion : QueryPerformanceCounter 두 값 사이의 시간(초)
+ * @Input : Start, End
+ * @Output : 경과 시간(초)
+ */
+double GetElapsedTime(LARGE_INTEGER Start, LARGE_INTEGER End)
+{
+	LARGE_INTEGER Freq;
+
+	QueryPerformanceFrequency(&Freq);
+
+	return (double)(End.QuadPart - Start.QuadPart) / (double)Freq.QuadPart;
+}
+
+/*
+ * @Function Name : EstimateFFTUnits
+ * @Descriotion : FFT Convolution 비용 단위 = (타일 수 + Kernel 1회) x 2회 변환 x N^2 log2(N)
+ * @Input : nWidth, nHeight, nKSize
+ * @Output : 비용 단위
+ */
+double EstimateFFTUnits(int nWidth, int nHeight, int nKSize)
+{
+	int N = SelectFFTSize(nKSize);
+	int T = N - nKSize + 1;
+	int nLog2 = 0;
+	double dTiles = (double)((nWidth + T - 1) / T) * ((nHeight + T - 1) / T);
+
+	while ((1 << nLog2) < N)
+		nLog2++;
+
+	return (dTiles * 2.0 + 1.0) * N * N * nLog2;
+}
+
+/*
+ * @Function Name : CalibrateConvolution
+ * @Descriotion : 합성 영상으로 직접 방식의 MAC당 시간과 FFT 방식의 단위 비용을 측정 (최초 1회)
+ * @Input :
+ * @Output : g_dDirectCost, g_dFFTCost
+ */
+void CalibrateConvolution(void)
+{
+	const int nW = 192, nH = 192, nK = 15;
+	LARGE_INTEGER Start, End;
+	double Kernel[15 * 15];
+
+	if (g_dDirectCost > 0.0 && g_dFFTCost > 0.0)
+		return;
+
+	BYTE* Src = (BYTE*)malloc(nW * nH);
+	BYTE* Dst = (BYTE*)malloc(nW * nH);
+
+	if (NULL == Src || NULL == Dst) {
+		free(Src);
+		free(Dst);
+		return;
+	}
+
+	for (int i = 0; i < nW * nH; i++)
+		Src[i] = (BYTE)((i * 31) ^ (i >> 7));
+	for (int i = 0; i < nK * nK; i++)
+		Kernel[i] = 1.0 / (nK * nK);
+
+	QueryPerformanceCounter(&Start);
+	DirectConvolution(Src, Dst, nW, nH, Kernel, nK);
+	QueryPerformanceCounter(&End);
+	g_dDirectCost = GetElapsedTime(Start, End) / ((double)(nW - nK + 1) * (nH - nK + 1) * nK * nK);
+
+	QueryPerformanceCounter(&Start);
+	FFTConvolution(Src, Dst, nW, nH, Kernel, nK);
+	QueryPerformanceCounter(&End);
+	g_dFFTCost = GetElapsedTime(Start, End) / EstimateFFTUnits(nW, nH, nK);
+
+	free(Src);
+	free(Dst);
+
+	return;
+}
+
+/*
+ * @Function Name : UseFFTConvolution
+ * @Descriotion : 측정된 비용으로 영상/Kernel 크기에 대해 FFT 방식이 더 빠른지 판단
+ * @Input : nWidth, nHeight, nKSize
+ * @Output : FFT 사용 1, 직접 방식 0
+ */
+int UseFFTConvolution(int nWidth, int nHeight, int nKSize)
+{
+	double dDirect, dFFT;
+
+	if (nKSize <= 3 || nWidth < nKSize || nHeight < nKSize)
+		return 0;
+
+	// 4096 이하 FFT 크기로 처리할 수 없는 Kernel
+	if (0 == SelectFFTSize(nKSize))
+		return 0;
+
+	CalibrateConvolution();
+
+	dDirect = g_dDirectCost * (nWidth - nKSize + 1) * (double)(nHeight - nKSize + 1) * nKSize * nKSize;
+	dFFT = g_dFFTCost * EstimateFFTUnits(nWidth, nHeight, nKSize);
+
+	return dFFT < dDirect;
+}
+
+/*
+ * @Function Name : FFTCrossoverKernelSize
+ * @Descriotion : 주어진 영상 크기에서 FFT 방식이 더 빨라지는 최소 Kernel 크기 (없으면 0)
+ * @Input : nWidth, nHeight
+ * @Output : Kernel 크기
+ */
+int FFTCrossoverKernelSize(int nWidth, int nHeight)
+{
+	for (int k = 3; k <= nWidth && k <= nHeight; k += 2)
+		if (UseFFTConvolution(nWidth, nHeight, k))
+			return k;
+
+	return 0;
+}
+
+/*
+ * @Function Name : KernelConvolution
+ * @Descriotion : 측정된 교차점에 따라 Direct / FFT Convolution을 자동으로 선택하여 수행
+ * @Input : *Input, nWidth, nHeight, *Kernel, nKSize
+ * @Output : *Output
+ */
+void KernelConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double* Kernel, int nKSize)
+{
+	PROFILE_BEGIN();
+
+	// FFT 버퍼 할당에 실패하면 직접 방식으로 수행
+	if (0 == UseFFTConvolution(nWidth, nHeight, nKSize) || 0 == FFTConvolution(Input, Output, nWidth, nHeight, Kernel, nKSize))
+		DirectConvolution(Input, Output, nWidth, nHeight, Kernel, nKSize);
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
+	return;
+}
+
+/*
+ * @Function Name : GenerateGaussianKernel
+ * @Descriotion : nKSize x nKSize 정규화된 Gaussian Kernel 생성 (sigma = nKSize / 6)
+ * @Input : nKSize
+ * @Output : *Kernel
+ */
+void GenerateGaussianKernel(double* Kernel, int nKSize)
+{
+	int r = nKSize / 2;
+	double dSigma = nKSize / 6.0;
+	double dSum = 0.0;
+
+	for (int m = -r; m <= r; m++) {
+		for (int n = -r; n <= r; n++) {
+			Kernel[(m + r) * nKSize + (n + r)] = exp(-(m * m + n * n) / (2.0 * dSigma * dSigma));
+			dSum += Kernel[(m + r) * nKSize + (n + r)];
+		}
+	}
+
+	for (int i = 0; i < nKSize * nKSize; i++)
+		Kernel[i] /= dSum;
+
+	return;
+}
+
+/*
+ * @Function Name : PushStack
+ * @Descriotion : 가변 크기 int Stack에 값을 추가 (가득 차면 2배로 확장)
+ * @Input : **pStack, *pSize, *pCap, nValue
+ * @Output : 성공 1, 메모리 할당 실패 0
+ */
+int PushStack(int** pStack, int* pSize, int* pCap, int nValue)
+{
+	if (*pSize == *pCap) {
+		int* pNew = (int*)realloc(*pStack, sizeof(int) * (*pCap) * 2);
+		if (NULL == pNew)
+			return 0;
+
+		*pStack = pNew;
+		*pCap *= 2;
+	}
+
+	(*pStack)[(*pSize)++] = nValue;
+
+	return 1;
+}
+
+/*
+ * @Function Name : CannySmoothRow
+ * @Descriotion : Canny 1단계 - GaussKernel을 적용한 한 행의 평활화 (GaussianConvolution과 동일, 경계는 원본 복사)
+ * @Input : *Input, nWidth, nHeight, nRow
+ * @Output : *Row
+ */
+void CannySmoothRow(BYTE* Input, BYTE* Row, int nWidth, int nHeight, int nRow)
+{
+	double SumProduct = 0.0;
+
+	if (nRow == 0 || nRow == nHeight - 1) {
+		memcpy(Row, &Input[nRow * nWidth], nWidth);
+		return;
+	}
+
+	Row[0] = Input[nRow * nWidth];
+	Row[nWidth - 1] = Input[nRow * nWidth + nWidth - 1];
+
+	for (int j = 1; j < nWidth - 1; j++) {
+		for (int m = -1; m <= 1; m++)
+			for (int n = -1; n <= 1; n++)
+				SumProduct += Input[(nRow + m) * nWidth + (j + n)] * GaussKernel[m + 1][n + 1];
+
+		Row[j] = (BYTE)SumProduct;
+		SumProduct = 0.0;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : CannyGradientRow
+ * @Descriotion : Canny 2단계 - SobelKernel_X, SobelKernel_Y로 한 행의 기울기 크기와 방향(0, 45, 90, 135도 -> 0 ~ 3)을 계산
+ *                크기는 (|Gx| + |Gy|) / 8 을 0 ~ 254 로 저장 (255는 Hysteresis의 Edge 표시용으로 예약)
+ * @Input : *Above, *Center, *Below (평활화된 3개 행), nWidth
+ * @Output : *Magnitude, *Direction
+ */
+void CannyGradientRow(BYTE* Above, BYTE* Center, BYTE* Below, BYTE* Magnitude, BYTE* Direction, int nWidth)
+{
+	BYTE* Rows[3] = { Above, Center, Below };
+	int nGx, nGy, nAbsX, nAbsY, nMag;
+
+	Magnitude[0] = Magnitude[nWidth - 1] = 0;
+	Direction[0] = Direction[nWidth - 1] = 0;
+
+	for (int j = 1; j < nWidth - 1; j++) {
+		nGx = nGy = 0;
+
+		for (int m = 0; m < 3; m++) {
+			for (int n = -1; n <= 1; n++) {
+				nGx += Rows[m][j + n] * (int)SobelKernel_X[m][n + 1];
+				nGy += Rows[m][j + n] * (int)SobelKernel_Y[m][n + 1];
+			}
+		}
+
+		nAbsX = abs(nGx);
+		nAbsY = abs(nGy);
+
+		// 0 ~ 2040 값을 /8 하여 0 ~ 254로 조정
+		nMag = (nAbsX + nAbsY) / 8;
+		Magnitude[j] = (BYTE)(nMag > 254 ? 254 : nMag);
+
+		// atan 없이 tan(22.5) = 106/256, tan(67.5) = 618/256 로 방향 양자화
+		if (nAbsY * 256 <= nAbsX * 106)
+			Direction[j] = 0;			// 수평 기울기 -> 좌우 비교
+		else if (nAbsY * 256 >= nAbsX * 618)
+			Direction[j] = 2;			// 수직 기울기 -> 상하 비교
+		else if ((nGx > 0) == (nGy > 0))
+			Direction[j] = 1;			// 우하향 기울기 -> 좌상/우하 비교
+		else
+			Direction[j] = 3;			// 좌하향 기울기 -> 우상/좌하 비교
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : CannyEdgeDetection
+ * @Descriotion : Gaussian 평활화 + Sobel 기울기 + 비최대 억제(NMS)를 몇 개의 행 버퍼만으로 한 번에 스트리밍 처리하고,
+ *                기울기 히스토그램에서 자동으로 구한 High / Low 임계값으로 Stack 기반 Hysteresis 연결을 수행
+ *                전체 영상 크기의 실수 중간 버퍼 없이 Output을 NMS 결과 저장에 재사용
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Output (Edge 255, 그 외 0), *pLow, *pHigh, 성공 1, 메모리 할당 실패 0 (Output은 0, 임계값 0)
+ */
+int CannyEdgeDetection(BYTE* Input, BYTE* Output, int nWidth, int nHeight, BYTE* pLow, BYTE* pHigh)
+{
+	PROFILE_BEGIN();
+
+	double dLowRatio = 0.4;			// Low 임계값 = High x 0.4
+
+	int nHisto[256] = { 0, };
+	int nImgSize = nWidth * nHeight;
+	int nResult = 1;
+	BYTE bLow = 1, bHigh = 1;
+
+	int nStackSize = 0, nStackCap = 4096;
+	int* Stack = NULL;
+	BYTE* Buffer = NULL;
+
+	// 3x3 미만 : Edge 없음
+	if (nWidth < 3 || nHeight < 3) {
+		memset(Output, 0, nImgSize);
+		bLow = bHigh = 0;
+		goto CLEANUP;
+	}
+
+	// 평활화 행 3개, 기울기 크기/방향 행 3개씩을 순환 버퍼로 사용
+	Buffer = (BYTE*)malloc(nWidth * 9);
+	Stack = (int*)malloc(sizeof(int) * nStackCap);
+
+	if (NULL == Buffer || NULL == Stack) {
+		nResult = 0;
+		goto CLEANUP;
+	}
+
+	BYTE* Smooth[3] = { Buffer, Buffer + nWidth, Buffer + nWidth * 2 };
+	BYTE* Mag[3] = { Buffer + nWidth * 3, Buffer + nWidth * 4, Buffer + nWidth * 5 };
+	BYTE* Dir[3] = { Buffer + nWidth * 6, Buffer + nWidth * 7, Buffer + nWidth * 8 };
+
+	// 1 ~ 3. 행 i+1을 평활화 -> 행 i의 기울기 -> 행 i-1의 NMS 순서로 진행
+	// 경계 행(0, nHeight-1)의 기울기는 0
+	memset(Mag[0], 0, nWidth);
+	memset(Mag[1], 0, nWidth);
+	CannySmoothRow(Input, Smooth[0], nWidth, nHeight, 0);
+	CannySmoothRow(Input, Smooth[1], nWidth, nHeight, 1);
+	memset(Output, 0, nWidth);
+
+	for (int i = 1; i < nHeight; i++) {
+		BYTE* temp;
+
+		// 행 i의 기울기 계산 (Mag[2]), 마지막 행은 0
+		if (i < nHeight - 1) {
+			CannySmoothRow(Input, Smooth[2], nWidth, nHeight, i + 1);
+			CannyGradientRow(Smooth[0], Smooth[1], Smooth[2], Mag[2], Dir[2], nWidth);
+
+			for (int j = 0; j < nWidth; j++)
+				nHisto[Mag[2][j]]++;
+
+			temp = Smooth[0]; Smooth[0] = Smooth[1]; Smooth[1] = Smooth[2]; Smooth[2] = temp;
+		}
+		else {
+			memset(Mag[2], 0, nWidth);
+		}
+
+		// 행 i-1의 비최대 억제 : 기울기 방향의 두 이웃보다 크지 않으면 제거
+		BYTE* pOut = &Output[(i - 1) * nWidth];
+		if (i - 1 > 0) {
+			pOut[0] = pOut[nWidth - 1] = 0;
+
+			for (int j = 1; j < nWidth - 1; j++) {
+				BYTE bMag = Mag[1][j];
+				BYTE bA, bB;
+
+				switch (Dir[1][j]) {
+				case 0: bA = Mag[1][j - 1]; bB = Mag[1][j + 1]; break;
+				case 1: bA = Mag[0][j - 1]; bB = Mag[2][j + 1]; break;
+				case 2: bA = Mag[0][j];     bB = Mag[2][j];     break;
+				default: bA = Mag[0][j + 1]; bB = Mag[2][j - 1]; break;
+				}
+
+				// 같은 값이 연속될 때 두 픽셀 두께가 되지 않도록 한쪽은 >, 다른 쪽은 >=
+				pOut[j] = (bMag > bA && bMag >= bB) ? bMag : 0;
+			}
+		}
+
+		temp = Mag[0]; Mag[0] = Mag[1]; Mag[1] = Mag[2]; Mag[2] = temp;
+		temp = Dir[0]; Dir[0] = Dir[1]; Dir[1] = Dir[2]; Dir[2] = temp;
+	}
+	memset(&Output[(nHeight - 1) * nWidth], 0, nWidth);
+
+	// 경계 행/열의 0 기울기도 포함하여 히스토그램 구성
+	nHisto[0] += nWidth * 2;
+
+	// 4. 기울기 히스토그램을 Gonzalez Method로 배경(잡음)과 Edge 두 그룹으로 나누어 High 임계값 결정
+	bHigh = GonzalezMethod(nHisto);
+	if (bHigh < 2)
+		bHigh = 2;
+	bLow = (BYTE)(dLowRatio * bHigh);
+	if (bLow < 1)
+		bLow = 1;
+
+	// 5. 분류 : High 이상은 Edge(255)로 표시하고 Stack에 추가, Low 이상은 약한 Edge 후보(1)
+	for (int i = 0; i < nImgSize; i++) {
+		if (Output[i] >= bHigh) {
+			Output[i] = 255;
+			if (0 == PushStack(&Stack, &nStackSize, &nStackCap, i)) {
+				nResult = 0;
+				goto CLEANUP;
+			}
+		}
+		else if (Output[i] >= bLow)
+			Output[i] = 1;
+		else
+			Output[i] = 0;
+	}
+
+	// 6. Hysteresis : 강한 Edge에 8방향으로 연결된 약한 Edge 후보를 Edge로 승격
+	while (nStackSize > 0) {
+		int nIdx = Stack[--nStackSize];
+		int y = nIdx / nWidth, x = nIdx % nWidth;
+
+		for (int m = -1; m <= 1; m++) {
+			for (int n = -1; n <= 1; n++) {
+				int nNext = (y + m) * nWidth + (x + n);
+
+				// 경계 픽셀은 항상 0이므로 (y + m), (x + n)은 영상 안에 있음
+				if (1 != Output[nNext])
+					continue;
+
+				Output[nNext] = 255;
+				if (0 == PushStack(&Stack, &nStackSize, &nStackCap, nNext)) {
+					nResult = 0;
+					goto CLEANUP;
+				}
+			}
+		}
+	}
+
+	// 연결되지 않은 약한 Edge 후보 제거
+	for (int i = 0; i < nImgSize; i++)
+		if (1 == Output[i])
+			Output[i] = 0;
+
+CLEANUP:
+	// 메모리 할당 실패 : 일부만 연결된 Edge를 남기지 않음
+	if (0 == nResult) {
+		memset(Output, 0, nImgSize);
+		bLow = bHigh = 0;
+	}
+
+	free(Buffer);
+	free(Stack);
+
+	*pLow = bLow;
+	*pHigh = bHigh;
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
+	return nResult;
+}
+
+/*
+ * ver 1.0 : 1bpp Packed / RLE8 Binarization
+ * 이진화 결과를 픽셀당 1바이트(0/255)로 만들지 않고, 임계값 비교와 동시에 1bpp 행 또는 RLE8 스트림으로 바로 출력
+ */
+
+/*
+ * @Function Name : GetPackedStride
+ * @Descriotion : 1bpp BMP 한 행의 바이트 수 (4바이트 정렬)
+ * @Input : nWidth
+ * @Output : 행 바이트 수
+ */
+int GetPackedStride(int nWidth)
+{
+	return ((nWidth + 31) / 32) * 4;
+}
+
+/*
+ * @Function Name : ReverseBits
+ * @Descriotion : 바이트의 비트 순서를 반전 (movemask는 첫 픽셀이 LSB, 1bpp BMP는 첫 픽셀이 MSB)
+ * @Input : bValue
+ * @Output : 반전된 바이트
+ */
+BYTE ReverseBits(BYTE bValue)
+{
+	static BYTE bTable[256];
+	static int nInit = 0;
+
+	if (0 == nInit) {
+		for (int i = 0; i < 256; i++) {
+			BYTE b = 0;
+			for (int k = 0; k < 8; k++)
+				if (i & (1 << k))
+					b |= (BYTE)(0x80 >> k);
+			bTable[i] = b;
+		}
+		nInit = 1;
+	}
+
+	return bTable[bValue];
+}
+
+/*
+ * @Function Name : ThresholdMask16
+ * @Descriotion : 16픽셀을 임계값과 비교하여 (Input >= bThreshold)인 픽셀을 비트로 반환 (bit i = 픽셀 i)
+ * @Input : *Input, bThreshold
+ * @Output : 16비트 마스크
+ */
+int ThresholdMask16(BYTE* Input, BYTE bThreshold)
+{
+#ifdef USE_SSE2
+	// 부호 없는 비교 : max(x, t) == x  <=>  x >= t
+	__m128i vThreshold = _mm_set1_epi8((char)bThreshold);
+	__m128i vPixel = _mm_loadu_si128((__m128i*)Input);
+
+	return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(vPixel, vThreshold), vPixel));
+#else
+	int nMask = 0;
+
+	for (int i = 0; i < 16; i++)
+		if (Input[i] >= bThreshold)
+			nMask |= 1 << i;
+
+	return nMask;
+#endif
+}
+
+/*
+ * @Function Name : GeneratePackedBinarization
+ * @Descriotion : bThreshold 값으로 이진화하면서 바로 1bpp 행(MSB가 첫 픽셀, 4바이트 정렬)으로 압축, 8비트 중간 영상 없음
+ * @Input : *Input, nWidth, nHeight, bThreshold
+ * @Output : *Output (GetPackedStride(nWidth) * nHeight 바이트)
+ */
+void GeneratePackedBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, BYTE bThreshold)
+{
+	PROFILE_BEGIN();
+
+	int nStride = GetPackedStride(nWidth);
+
+	for (int i = 0; i < nHeight; i++) {
+		BYTE* pIn = &Input[i * nWidth];
+		BYTE* pOut = &Output[i * nStride];
+		int j = 0;
+
+		memset(pOut, 0, nStride);
+
+		// 16픽셀씩 비교 -> 2바이트
+		for (; j + 16 <= nWidth; j += 16) {
+			int nMask = ThresholdMask16(&pIn[j], bThreshold);
+
+			pOut[j >> 3] = ReverseBits((BYTE)(nMask & 0xFF));
+			pOut[(j >> 3) + 1] = ReverseBits((BYTE)(nMask >> 8));
+		}
+
+		// 나머지 픽셀
+		for (; j < nWidth; j++)
+			if (pIn[j] >= bThreshold)
+				pOut[j >> 3] |= (BYTE)(0x80 >> (j & 7));
+	}
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, GetPackedStride(nWidth) * nHeight);
+
+	return;
+}
+
+/*
+ * @Function Name : PutRLERun
+ * @Descriotion : RLE8 Encoded mode로 (개수, 색) 쌍을 255개 단위로 나누어 기록
+ * @Input : *Output, *pPos, nCapacity, nCount, bColor
+ * @Output : *Output, *pPos, 성공 1, 용량 초과 0
+ */
+int PutRLERun(BYTE* Output, int* pPos, int nCapacity, int nCount, BYTE bColor)
+{
+	while (nCount > 0) {
+		int nRun = nCount > 255 ? 255 : nCount;
+
+		if (*pPos + 2 > nCapacity)
+			return 0;
+
+		Output[(*pPos)++] = (BYTE)nRun;
+		Output[(*pPos)++] = bColor;
+		nCount -= nRun;
+	}
+
+	return 1;
+}
+
+/*
+ * @Function Name : GenerateRLEBinarization
+ * @Descriotion : bThreshold 값으로 이진화하면서 바로 BMP RLE8(BI_RLE8) 스트림으로 부호화 (빈 페이지가 많은 스캔 영상용)
+ *                16픽셀 단위 비교 마스크가 모두 같으면 Run을 16씩 연장
+ * @Input : *Input, nWidth, nHeight, bThreshold, nCapacity(Output 버퍼 크기)
+ * @Output : *Output, 부호화된 바이트 수 (nCapacity를 넘으면 0)
+ */
+int GenerateRLEBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, BYTE bThreshold, int nCapacity)
+{
+	PROFILE_BEGIN();
+
+	int nPos = 0;
+
+	for (int i = 0; i < nHeight; i++) {
+		BYTE* pIn = &Input[i * nWidth];
+		int j = 0;
+
+		while (j < nWidth) {
+			int nStart = j;
+			int nValue = pIn[j] >= bThreshold;
+			int nSame = nValue ? 0xFFFF : 0;
+
+			j++;
+
+			// 같은 값이 이어지는 동안 16픽셀씩 건너뜀
+			while (j < nWidth) {
+				if (j + 16 <= nWidth) {
+					int nDiff = ThresholdMask16(&pIn[j], bThreshold) ^ nSame;
+
+					if (0 == nDiff) {
+						j += 16;
+						continue;
+					}
+
+					while (0 == (nDiff & 1)) {
+						nDiff >>= 1;
+						j++;
+					}
+					break;
+				}
+
+				if ((pIn[j] >= bThreshold) != nValue)
+					break;
+				j++;
+			}
+
+			if (0 == PutRLERun(Output, &nPos, nCapacity, j - nStart, nValue ? 255 : 0)) {
+				nPos = 0;
+				goto CLEANUP;
+			}
+		}
+
+		// 행 끝(0, 0), 마지막 행은 Bitmap 끝(0, 1)
+		if (nPos + 2 > nCapacity) {
+			nPos = 0;
+			goto CLEANUP;
+		}
+
+		Output[nPos++] = 0;
+		Output[nPos++] = (i == nHeight - 1) ? 1 : 0;
+	}
+
+CLEANUP:
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nPos);
+
+	return nPos;
+}
+
+/*
+ * ver 1.1 : 다중 스레드 행 띠(band) 처리 + Connected Component Labeling
+ */
+
+#define MAX_THREADS 64		// 최대 스레드(행 띠) 수
+
+// 행 띠 처리 함수 : [nStartRow, nEndRow) 행을 처리
+typedef void (*BAND_FUNC)(void* pParam, int nBand, int nStartRow, int nEndRow);
+
+typedef struct {
+	BAND_FUNC Func;
+	void* pParam;
+	int nBand;
+	int nStartRow;
+	int nEndRow;
+	int nBands;		// 전체 띠 수 (스레드 고정 Node 계산)
+} BAND_TASK;
+
+/*
+ * ver 2.1 : NUMA / Large Page Frame 할당 정책
+ * Frame 버퍼는 VirtualAlloc으로 할당하고, 처리와 같은 행 띠 분할로 병렬 first-touch 하여 띠의 페이지가 처리할 스레드의 Node에 놓이게 함
+ * NUMA Node가 하나이면 2MB Large Page 사용 (SeLockMemoryPrivilege 필요, 없으면 일반 페이지)
+ * 환경 변수 IMGPROC_PIN_THREADS=1 이면 띠 b / nBands를 Node (b x Node 수 / nBands)에 띠 처리 동안만 고정 (끝나면 이전 affinity 복원)
+ * (띠 수가 달라도 행 y는 대략 Node (y x Node 수 / 행 수)에 대응)
+ */
+
+#define MAX_NUMA_NODES		64
+
+typedef struct {
+	int bInit;
+	int nNodes;
+	ULONGLONG ullNodeMask[MAX_NUMA_NODES];	// Node별 프로세서 mask
+	SIZE_T nLargePage;						// Large Page 크기 (사용할 수 없으면 0)
+	int bPinThreads;
+} MEMORY_POLICY;
+
+static MEMORY_POLICY g_MemoryPolicy;
+
+/*
+ * @Function Name : EnableLockMemoryPrivilege
+ * @Descriotion : Large Page 할당에 필요한 SeLockMemoryPrivilege를 현재 프로세스 토큰에서 활성화
+ * @Input :
+ * @Output : 성공 1, 실패 0
+ */
+int EnableLockMemoryPrivilege(void)
+{
+	HANDLE hToken;
+	TOKEN_PRIVILEGES Privileges;
+	BOOL bOk;
+
+	if (!OpenProcessToken(GetCurrentProcess(), TOKEN_ADJUST_PRIVILEGES | TOKEN_QUERY, &hToken))
+		return 0;
+
+	Privileges.PrivilegeCount = 1;
+	Privileges.Privileges[0].Attributes = SE_PRIVILEGE_ENABLED;
+
+	bOk = LookupPrivilegeValueA(NULL, "SeLockMemoryPrivilege", &Privileges.Privileges[0].Luid) &&
+		AdjustTokenPrivileges(hToken, FALSE, &Privileges, 0, NULL, NULL) && ERROR_SUCCESS == GetLastError();
+
+	CloseHandle(hToken);
+
+	return bOk ? 1 : 0;
+}
+
+/*
+ * @Function Name : InitMemoryPolicy
+ * @Descriotion : NUMA Node 구성, Large Page 사용 가능 여부, 스레드 고정 설정 확인 (최초 1회)
+ * @Input :
+ * @Output : g_MemoryPolicy
+ */
+void InitMemoryPolicy(void)
+{
+	ULONG ulHighest = 0;
+	char Value[8] = { 0, };
+
+	if (g_MemoryPolicy.bInit)
+		return;
+
+	g_MemoryPolicy.nNodes = 1;
+	g_MemoryPolicy.ullNodeMask[0] = 0;
+
+	if (GetNumaHighestNodeNumber(&ulHighest) && ulHighest > 0) {
+		int nNodes = 0;
+
+		// 프로세서가 없는 Node는 제외
+		for (ULONG n = 0; n <= ulHighest && nNodes < MAX_NUMA_NODES; n++) {
+			ULONGLONG ullMask = 0;
+
+			if (GetNumaNodeProcessorMask((UCHAR)n, &ullMask) && 0 != ullMask)
+				g_MemoryPolicy.ullNodeMask[nNodes++] = ullMask;
+		}
+
+		if (nNodes > 0)
+			g_MemoryPolicy.nNodes = nNodes;
+	}
+
+	if (GetLargePageMinimum() > 0 && EnableLockMemoryPrivilege())
+		g_MemoryPolicy.nLargePage = GetLargePageMinimum();
+
+	if (GetEnvironmentVariableA("IMGPROC_PIN_THREADS", Value, sizeof(Value)) > 0 && '1' == Value[0])
+		g_MemoryPolicy.bPinThreads = 1;
+
+	g_MemoryPolicy.bInit = 1;
+
+	return;
+}
+
+/*
+ * @Function Name : PinBandThread
+ * @Descriotion : 스레드 고정이 켜져 있고 Node가 둘 이상이면 현재 스레드를 띠에 대응하는 Node의 프로세서로 고정
+ *                0번 띠는 호출 스레드(main, 상주 작업 스레드)에서 수행되므로 띠 처리 후 반환한 이전 mask로 되돌려야 함
+ * @Input : nBand, nBands
+ * @Output : 고정 전 affinity mask (고정하지 않았거나 실패하면 0)
+ */
+DWORD_PTR PinBandThread(int nBand, int nBands)
+{
+	int nNode;
+
+	if (!g_MemoryPolicy.bPinThreads || g_MemoryPolicy.nNodes < 2)
+		return 0;
+
+	nNode = (int)((long long)nBand * g_MemoryPolicy.nNodes / nBands);
+
+	return SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)g_MemoryPolicy.ullNodeMask[nNode]);
+}
+
+/*
+ * @Function Name : BandThreadProc
+ * @Descriotion : 행 띠 하나를 처리하는 스레드 진입점
+ * @Input : lpParam (BAND_TASK*)
+ * @Output : 0
+ */
+DWORD WINAPI BandThreadProc(LPVOID lpParam)
+{
+	BAND_TASK* pTask = (BAND_TASK*)lpParam;
+	DWORD_PTR dwPrevMask = PinBandThread(pTask->nBand, pTask->nBands);
+
+#ifdef ENABLE_PROFILE
+	ULONG64 ullStart = 0, ullEnd = 0;
+	QueryThreadCycleTime(GetCurrentThread(), &ullStart);
+#endif
+
+	pTask->Func(pTask->pParam, pTask->nBand, pTask->nStartRow, pTask->nEndRow);
+
+#ifdef ENABLE_PROFILE
+	QueryThreadCycleTime(GetCurrentThread(), &ullEnd);
+	InterlockedExchangeAdd64(&g_llBandCycles, (LONGLONG)(ullEnd - ullStart));
+#endif
+
+	// 호출 스레드나 상주 작업 스레드가 다음 작업에서 Node에 고정된 채로 남지 않도록 복원
+	if (0 != dwPrevMask)
+		SetThreadAffinityMask(GetCurrentThread(), dwPrevMask);
+
+	return 0;
+}
+
+/*
+ * @Function Name : GetThreadCount
+ * @Descriotion : 사용할 스레드 수 (논리 프로세서 수, 최대 MAX_THREADS)
+ * @Input :
+ * @Output : 스레드 수
+ */
+int GetThreadCount(void)
+{
+	SYSTEM_INFO SysInfo;
+
+	GetSystemInfo(&SysInfo);
+
+	if (SysInfo.dwNumberOfProcessors < 1)
+		return 1;
+	if (SysInfo.dwNumberOfProcessors > MAX_THREADS)
+		return MAX_THREADS;
+
+	return (int)SysInfo.dwNumberOfProcessors;
+}
+
+/*
+ * @Function Name : GetBandCount
+ * @Descriotion : 띠 하나가 최소 nMinRows 행이 되도록 행 띠 수를 결정
+ * @Input : nRows, nMinRows
+ * @Output : 행 띠 수 (1 ~ GetThreadCount())
+ */
+int GetBandCount(int nRows, int nMinRows)
+{
+	int nBands = GetThreadCount();
+
+	if (nMinRows < 1)
+		nMinRows = 1;
+	if (nBands > nRows / nMinRows)
+		nBands = nRows / nMinRows;
+
+	return nBands < 1 ? 1 : nBands;
+}
+
+// 상주 작업 스레드 (Daemon 모드에서 요청마다 스레드를 만들지 않도록 유지)
+typedef struct {
+	int nWorkers;
+	HANDLE hThread[MAX_THREADS];
+	HANDLE hStart[MAX_THREADS];		// 작업 시작 알림 (auto-reset)
+	HANDLE hDone[MAX_THREADS];		// 작업 완료 알림 (auto-reset)
+	BAND_TASK* pTask[MAX_THREADS];
+	volatile LONG lStop;
+} BAND_POOL;
+
+static BAND_POOL g_BandPool;
+
+/*
+ * @Function Name : BandWorkerProc
+ * @Descriotion : 상주 작업 스레드 - 시작 알림을 기다렸다가 배정된 띠를 처리하고 완료 알림
+ * @Input : lpParam (작업 스레드 번호)
+ * @Output : 0
+ */
+DWORD WINAPI BandWorkerProc(LPVOID lpParam)
+{
+	int nIndex = (int)(INT_PTR)lpParam;
+
+	while (1) {
+		WaitForSingleObject(g_BandPool.hStart[nIndex], INFINITE);
+
+		if (g_BandPool.lStop)
+			break;
+
+		BandThreadProc(g_BandPool.pTask[nIndex]);
+		SetEvent(g_BandPool.hDone[nIndex]);
+	}
+
+	return 0;
+}
+
+/*
+ * @Function Name : StartBandWorkers
+ * @Descriotion : GetThreadCount() - 1 개의 상주 작업 스레드 생성 (호출 스레드가 0번 띠를 처리)
+ *                RunBands를 동시에 여러 스레드에서 호출하지 않는 경우에만 사용
+ * @Input :
+ * @Output : 생성된 작업 스레드 수
+ */
+int StartBandWorkers(void)
+{
+	int nWorkers = GetThreadCount() - 1;
+
+	g_BandPool.lStop = 0;
+
+	for (int i = g_BandPool.nWorkers; i < nWorkers; i++) {
+		g_BandPool.hStart[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
+		g_BandPool.hDone[i] = CreateEvent(NULL, FALSE, FALSE, NULL);
+
+		if (NULL != g_BandPool.hStart[i] && NULL != g_BandPool.hDone[i])
+			g_BandPool.hThread[i] = CreateThread(NULL, 0, BandWorkerProc, (LPVOID)(INT_PTR)i, 0, NULL);
+
+		if (NULL == g_BandPool.hStart[i] || NULL == g_BandPool.hDone[i] || NULL == g_BandPool.hThread[i]) {
+			if (NULL != g_BandPool.hStart[i])
+				CloseHandle(g_BandPool.hStart[i]);
+			if (NULL != g_BandPool.hDone[i])
+				CloseHandle(g_BandPool.hDone[i]);
+			break;
+		}
+
+		g_BandPool.nWorkers++;
+	}
+
+	return g_BandPool.nWorkers;
+}
+
+/*
+ * @Function Name : StopBandWorkers
+ * @Descriotion : 상주 작업 스레드 종료 및 핸들 해제
+ * @Input :
+ * @Output :
+ */
+void StopBandWorkers(void)
+{
+	g_BandPool.lStop = 1;
+
+	for (int i = 0; i < g_BandPool.nWorkers; i++)
+		SetEvent(g_BandPool.hStart[i]);
+
+	if (g_BandPool.nWorkers > 0)
+		WaitForMultipleObjects(g_BandPool.nWorkers, g_BandPool.hThread, TRUE, INFINITE);
+
+	for (int i = 0; i < g_BandPool.nWorkers; i++) {
+		CloseHandle(g_BandPool.hThread[i]);
+		CloseHandle(g_BandPool.hStart[i]);
+		CloseHandle(g_BandPool.hDone[i]);
+	}
+
+	g_BandPool.nWorkers = 0;
+
+	return;
+}
+
+/*
+ * @Function Name : RunBands
+ * @Descriotion : nRows 행을 nBands개의 띠로 나누어 Func를 병렬 수행 (0번 띠는 호출 스레드에서 수행)
+ *                상주 작업 스레드가 충분하면 재사용하고, 아니면 띠마다 스레드를 생성
+ * @Input : Func, *pParam, nRows, nBands
+ * @Output :
+ */
+void RunBands(BAND_FUNC Func, void* pParam, int nRows, int nBands)
+{
+	BAND_TASK Task[MAX_THREADS];
+	HANDLE hThread[MAX_THREADS];
+	int nCreated = 0;
+
+	if (nBands < 1)
+		nBands = 1;
+	if (nBands > MAX_THREADS)
+		nBands = MAX_THREADS;
+
+#ifdef ENABLE_PROFILE
+	ULONGLONG ullStart = __rdtsc();
+#endif
+
+	for (int b = 0; b < nBands; b++) {
+		Task[b].Func = Func;
+		Task[b].pParam = pParam;
+		Task[b].nBand = b;
+		Task[b].nStartRow = (int)((long long)nRows * b / nBands);
+		Task[b].nEndRow = (int)((long long)nRows * (b + 1) / nBands);
+		Task[b].nBands = nBands;
+	}
+
+	if (g_BandPool.nWorkers >= nBands - 1) {
+		// 상주 작업 스레드에 1 ~ nBands-1 번 띠 배정
+		for (int b = 1; b < nBands; b++) {
+			g_BandPool.pTask[b - 1] = &Task[b];
+			SetEvent(g_BandPool.hStart[b - 1]);
+		}
+
+		BandThreadProc(&Task[0]);
+
+		if (nBands > 1)
+			WaitForMultipleObjects(nBands - 1, g_BandPool.hDone, TRUE, INFINITE);
+
+#ifdef ENABLE_PROFILE
+		InterlockedExchangeAdd64(&g_llBandSlots, (LONGLONG)((__rdtsc() - ullStart) * nBands));
+#endif
+		return;
+	}
+
+	for (int b = 1; b < nBands; b++) {
+		hThread[nCreated] = CreateThread(NULL, 0, BandThreadProc, &Task[b], 0, NULL);
+
+		// 스레드 생성에 실패하면 호출 스레드에서 직접 수행
+		if (NULL == hThread[nCreated])
+			BandThreadProc(&Task[b]);
+		else
+			nCreated++;
+	}
+
+	BandThreadProc(&Task[0]);
+
+	if (nCreated > 0)
+		WaitForMultipleObjects(nCreated, hThread, TRUE, INFINITE);
+
+	for (int i = 0; i < nCreated; i++)
+		CloseHandle(hThread[i]);
+
+#ifdef ENABLE_PROFILE
+	InterlockedExchangeAdd64(&g_llBandSlots, (LONGLONG)((__rdtsc() - ullStart) * nBands));
+#endif
+
+	return;
+}
+
+typedef struct {
+	BYTE* Buffer;
+	SIZE_T nSize;
+	int nRows;
+} FIRST_TOUCH_PARAM;
+
+/*
+ * @Function Name : FirstTouchBand
+ * @Descriotion : RunBands용 - 띠에 해당하는 버퍼 구간을 처음 써서 (0으로 초기화) 띠를 처리할 스레드의 Node에 페이지 배치
+ * @Input : pParam(FIRST_TOUCH_PARAM), nBand, nStartRow, nEndRow
+ * @Output : FIRST_TOUCH_PARAM->Buffer
+ */
+void FirstTouchBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	FIRST_TOUCH_PARAM* p = (FIRST_TOUCH_PARAM*)pParam;
+	SIZE_T nStart = (SIZE_T)((long long)p->nSize * nStartRow / p->nRows);
+	SIZE_T nEnd = (SIZE_T)((long long)p->nSize * nEndRow / p->nRows);
+
+	memset(&p->Buffer[nStart], 0, nEnd - nStart);
+
+	return;
+}
+
+/*
+ * @Function Name : AllocFrame
+ * @Descriotion : Frame 버퍼 할당 (0으로 초기화)
+ *                Node가 하나이고 Large Page를 쓸 수 있으면 Large Page, 아니면 일반 페이지 + 행 띠 병렬 first-touch
+ * @Input : nSize, nRows (처리할 때의 행 수)
+ * @Output : 버퍼 (실패 시 NULL), FreeFrame으로 해제
+ */
+BYTE* AllocFrame(SIZE_T nSize, int nRows)
+{
+	FIRST_TOUCH_PARAM Param;
+	BYTE* Buffer = NULL;
+
+	InitMemoryPolicy();
+
+	if (0 == nSize)
+		nSize = 1;
+
+	// Large Page는 할당 시점에 물리 메모리가 정해지므로 first-touch 배치가 필요 없는 단일 Node에서만 사용
+	if (g_MemoryPolicy.nLargePage > 0 && 1 == g_MemoryPolicy.nNodes && nSize >= g_MemoryPolicy.nLargePage) {
+		SIZE_T nLarge = (nSize + g_MemoryPolicy.nLargePage - 1) / g_MemoryPolicy.nLargePage * g_MemoryPolicy.nLargePage;
+
+		Buffer = (BYTE*)VirtualAlloc(NULL, nLarge, MEM_RESERVE | MEM_COMMIT | MEM_LARGE_PAGES, PAGE_READWRITE);
+		if (NULL != Buffer)
+			return Buffer;
+	}
+
+	// 일반 페이지는 처음 쓰는 스레드의 Node에 물리 페이지가 배치됨
+	Buffer = (BYTE*)VirtualAlloc(NULL, nSize, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (NULL == Buffer)
+		return NULL;
+
+	if (nRows < 1)
+		nRows = 1;
+
+	Param.Buffer = Buffer;
+	Param.nSize = nSize;
+	Param.nRows = nRows;
+	RunBands(FirstTouchBand, &Param, nRows, GetBandCount(nRows, 8));
+
+	return Buffer;
+}
+
+/*
+ * @Function Name : FreeFrame
+ * @Descriotion : AllocFrame으로 할당한 버퍼 해제
+ * @Input : *Buffer
+ * @Output :
+ */
+void FreeFrame(BYTE* Buffer)
+{
+	if (NULL != Buffer)
+		VirtualFree(Buffer, 0, MEM_RELEASE);
+
+	return;
+}
+
+/*
+ * ver 2.2 : 읽기 시점 영상 통계 (히스토그램, 최소/최대, 합, 제곱합)
+ */
+
+#define STATS_CHUNK_BYTES	(64 * 1024)		// 읽은 직후 Cache에 남아 있는 동안 통계를 누적할 읽기 단위
+#define STATS_MIN_ROWS		16				// 통계 띠 하나의 최소 행 수
+
+// 행 띠 하나의 부분 통계
+typedef struct {
+	int nStartRow;
+	int nEndRow;
+	int bDirty;				// 띠 내용이 바뀌어 다시 계산해야 함
+	int nHisto[256];
+	BYTE bMin;
+	BYTE bMax;
+	long long llSum;
+	long long llSqSum;
+} BAND_STATS;
+
+// 영상과 함께 보관하는 통계 (띠별 부분 통계를 합친 결과)
+typedef struct {
+	const BYTE* Image;		// 통계를 계산한 버퍼
+	int nWidth;
+	int nHeight;
+	int bValid;				// 합친 결과가 모든 띠와 일치
+	int nBands;
+	BAND_STATS Band[MAX_THREADS];
+	int nHisto[256];
+	BYTE bMin;
+	BYTE bMax;
+	long long llSum;
+	long long llSqSum;
+} IMAGE_STATS;
+
+/*
+ * @Function Name : AccumulateStats
+ * @Descriotion : 띠의 히스토그램에 픽셀을 누적
+ *                같은 밝기가 연속될 때 한 카운터에 대한 저장-읽기 의존이 생기지 않도록 4개의 보조 히스토그램에 나누어 누적
+ * @Input : *Band, *Data, nSize
+ * @Output : Band->nHisto
+ */
+void AccumulateStats(BAND_STATS* Band, const BYTE* Data, int nSize)
+{
+	int nSub[4][256] = { 0, };
+	int i = 0;
+
+	for (; i + 4 <= nSize; i += 4) {
+		nSub[0][Data[i]]++;
+		nSub[1][Data[i + 1]]++;
+		nSub[2][Data[i + 2]]++;
+		nSub[3][Data[i + 3]]++;
+	}
+	for (; i < nSize; i++)
+		nSub[0][Data[i]]++;
+
+	for (int v = 0; v < 256; v++)
+		Band->nHisto[v] += nSub[0][v] + nSub[1][v] + nSub[2][v] + nSub[3][v];
+
+	return;
+}
+
+/*
+ * @Function Name : FinishBandStats
+ * @Descriotion : 띠의 히스토그램에서 최소/최대, 합, 제곱합을 계산 (픽셀을 다시 읽지 않음)
+ * @Input : *Band
+ * @Output : Band->bMin, bMax, llSum, llSqSum
+ */
+void FinishBandStats(BAND_STATS* Band)
+{
+	Band->bMin = 255;
+	Band->bMax = 0;
+	Band->llSum = 0;
+	Band->llSqSum = 0;
+
+	for (int v = 0; v < 256; v++) {
+		if (0 == Band->nHisto[v])
+			continue;
+
+		if (v < Band->bMin)
+			Band->bMin = (BYTE)v;
+		Band->bMax = (BYTE)v;
+		Band->llSum += (long long)Band->nHisto[v] * v;
+		Band->llSqSum += (long long)Band->nHisto[v] * v * v;
+	}
+
+	Band->bDirty = 0;
+
+	return;
+}
+
+/*
+ * @Function Name : InitImageStats
+ * @Descriotion : 통계를 버퍼에 연결하고 모든 띠를 다시 계산할 대상으로 표시
+ *                띠 구간은 RunBands가 나누는 구간과 같음
+ * @Input : *Stats, *Image, nWidth, nHeight
+ * @Output : *Stats
+ */
+void InitImageStats(IMAGE_STATS* Stats, const BYTE* Image, int nWidth, int nHeight)
+{
+	Stats->Image = Image;
+	Stats->nWidth = nWidth;
+	Stats->nHeight = nHeight;
+	Stats->bValid = 0;
+	Stats->nBands = GetBandCount(nHeight, STATS_MIN_ROWS);
+
+	for (int b = 0; b < Stats->nBands; b++) {
+		Stats->Band[b].nStartRow = (int)((long long)nHeight * b / Stats->nBands);
+		Stats->Band[b].nEndRow = (int)((long long)nHeight * (b + 1) / Stats->nBands);
+		Stats->Band[b].bDirty = 1;
+		memset(Stats->Band[b].nHisto, 0, sizeof(Stats->Band[b].nHisto));
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : MergeImageStats
+ * @Descriotion : 띠별 부분 통계를 영상 전체 통계로 합침
+ * @Input : *Stats
+ * @Output : Stats->nHisto, bMin, bMax, llSum, llSqSum
+ */
+void MergeImageStats(IMAGE_STATS* Stats)
+{
+	memset(Stats->nHisto, 0, sizeof(Stats->nHisto));
+	Stats->bMin = 255;
+	Stats->bMax = 0;
+	Stats->llSum = 0;
+	Stats->llSqSum = 0;
+
+	for (int b = 0; b < Stats->nBands; b++) {
+		BAND_STATS* Band = &Stats->Band[b];
+
+		// 빈 띠(행 0개)는 최소/최대에 포함하지 않음
+		if (Band->nEndRow <= Band->nStartRow)
+			continue;
+
+		for (int v = 0; v < 256; v++)
+			Stats->nHisto[v] += Band->nHisto[v];
+
+		if (Band->bMin < Stats->bMin)
+			Stats->bMin = Band->bMin;
+		if (Band->bMax > Stats->bMax)
+			Stats->bMax = Band->bMax;
+		Stats->llSum += Band->llSum;
+		Stats->llSqSum += Band->llSqSum;
+	}
+
+	// 빈 영상은 GenerateHistogram 결과와 같이 최소/최대 0
+	if (Stats->bMin > Stats->bMax)
+		Stats->bMin = Stats->bMax = 0;
+
+	Stats->bValid = 1;
+
+	return;
+}
+
+/*
+ * @Function Name : ImageStatsBand
+ * @Descriotion : RunBands용 - 다시 계산할 대상으로 표시된 띠의 부분 통계를 계산
+ * @Input : pParam(IMAGE_STATS), nBand, nStartRow, nEndRow
+ * @Output : IMAGE_STATS->Band[nBand]
+ */
+void ImageStatsBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	IMAGE_STATS* Stats = (IMAGE_STATS*)pParam;
+	BAND_STATS* Band = &Stats->Band[nBand];
+
+	if (0 == Band->bDirty)
+		return;
+
+	memset(Band->nHisto, 0, sizeof(Band->nHisto));
+	AccumulateStats(Band, &Stats->Image[(SIZE_T)nStartRow * Stats->nWidth], (nEndRow - nStartRow) * Stats->nWidth);
+	FinishBandStats(Band);
+
+	return;
+}
+
+/*
+ * @Function Name : ReadImageWithStats
+ * @Descriotion : 픽셀 데이터를 읽으면서 같은 패스에서 띠별 통계를 누적
+ *                STATS_CHUNK_BYTES 단위로 읽어 방금 복사된 데이터가 Cache에 있는 동안 히스토그램에 반영
+ * @Input : *fp (픽셀 데이터 위치), nWidth, nHeight
+ * @Output : *Image, *Stats, 읽은 바이트 수
+ */
+SIZE_T ReadImageWithStats(FILE* fp, BYTE* Image, int nWidth, int nHeight, IMAGE_STATS* Stats)
+{
+	SIZE_T nTotal = 0;
+	int nChunkRows = STATS_CHUNK_BYTES / (nWidth > 0 ? nWidth : 1);
+
+	if (nChunkRows < 1)
+		nChunkRows = 1;
+
+	InitImageStats(Stats, Image, nWidth, nHeight);
+
+	for (int b = 0; b < Stats->nBands; b++) {
+		BAND_STATS* Band = &Stats->Band[b];
+
+		for (int y = Band->nStartRow; y < Band->nEndRow; y += nChunkRows) {
+			int nRows = (Band->nEndRow - y < nChunkRows) ? Band->nEndRow - y : nChunkRows;
+			BYTE* Chunk = &Image[(SIZE_T)y * nWidth];
+
+			nTotal += fread(Chunk, sizeof(BYTE), (SIZE_T)nRows * nWidth, fp);
+
+			// 짧게 읽힌 부분도 버퍼 내용(0) 그대로 통계에 포함
+			AccumulateStats(Band, Chunk, nRows * nWidth);
+		}
+
+		FinishBandStats(Band);
+	}
+
+	MergeImageStats(Stats);
+
+	return nTotal;
+}
+
+/*
+ * @Function Name : InvalidateImageStats
+ * @Descriotion : 버퍼의 nStartRow ~ nEndRow-1 행이 바뀌었음을 표시 (다음 GetImageStats에서 해당 띠만 다시 계산)
+ *                통계가 연결된 버퍼를 제자리에서 바꾸는 쪽은 반드시 호출
+ * @Input : *Stats, nStartRow, nEndRow
+ * @Output : *Stats
+ */
+void InvalidateImageStats(IMAGE_STATS* Stats, int nStartRow, int nEndRow)
+{
+	for (int b = 0; b < Stats->nBands; b++) {
+		if (Stats->Band[b].nStartRow < nEndRow && nStartRow < Stats->Band[b].nEndRow) {
+			Stats->Band[b].bDirty = 1;
+			Stats->bValid = 0;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : GetImageStats
+ * @Descriotion : 버퍼의 통계를 반환
+ *                보관된 통계가 같은 버퍼/크기이면 InvalidateImageStats로 표시된 띠만 다시 계산하고, 다른 버퍼이면 전체를 띠 병렬로 계산
+ * @Input : *Stats, *Image, nWidth, nHeight
+ * @Output : *Stats (nHisto, bMin, bMax, llSum, llSqSum)
+ */
+IMAGE_STATS* GetImageStats(IMAGE_STATS* Stats, const BYTE* Image, int nWidth, int nHeight)
+{
+	if (Stats->Image != Image || Stats->nWidth != nWidth || Stats->nHeight != nHeight || Stats->nBands < 1)
+		InitImageStats(Stats, Image, nWidth, nHeight);
+
+	if (0 == Stats->bValid) {
+		RunBands(ImageStatsBand, Stats, nHeight, Stats->nBands);
+		MergeImageStats(Stats);
+	}
+
+	return Stats;
+}
+
+// 한 행에서 연속된 전경(0이 아닌) 픽셀 구간
+typedef struct {
+	int nRow;
+	int nStart;		// 시작 열
+	int nEnd;		// 마지막 열 + 1
+} RUN;
+
+// Connected Component 통계
+typedef struct {
+	int nArea;							// 픽셀 수
+	int nLeft, nTop, nRight, nBottom;	// Bounding Box (포함)
+	double dCenterX, dCenterY;			// 무게 중심
+} BLOB_STATS;
+
+// 행 띠별 Labeling 작업 데이터
+typedef struct {
+	BYTE* Input;
+	int* Labels;
+	int nWidth;
+	int nConnectivity;			// 4 또는 8
+	RUN* Runs[MAX_THREADS];		// 띠별 Run 목록
+	int* Parent[MAX_THREADS];	// 띠별 Union-Find 부모 (띠 내부 인덱스)
+	int nRuns[MAX_THREADS];
+	int nOffset[MAX_THREADS];	// 띠의 첫 Run의 전체 인덱스
+	int* RunLabel;				// Run별 최종 Label (1 ~)
+	int nError;
+} CCL_PARAM;
+
+/*
+ * @Function Name : FindRoot
+ * @Descriotion : Union-Find 루트 탐색 (경로 절반 압축)
+ * @Input : *Parent, n
+ * @Output : 루트 인덱스
+ */
+int FindRoot(int* Parent, int n)
+{
+	while (Parent[n] != n) {
+		Parent[n] = Parent[Parent[n]];
+		n = Parent[n];
+	}
+
+	return n;
+}
+
+/*
+ * @Function Name : UnionRoot
+ * @Descriotion : 두 원소의 집합을 합침, 항상 작은 인덱스가 루트가 되도록 연결
+ * @Input : *Parent, a, b
+ * @Output : *Parent
+ */
+void UnionRoot(int* Parent, int a, int b)
+{
+	a = FindRoot(Parent, a);
+	b = FindRoot(Parent, b);
+
+	if (a < b)
+		Parent[b] = a;
+	else if (b < a)
+		Parent[a] = b;
+
+	return;
+}
+
+/*
+ * @Function Name : UnionOverlapRuns
+ * @Descriotion : 인접한 두 행의 Run 목록에서 연결(4: 열 겹침, 8: 대각 포함)되는 Run끼리 Union
+ * @Input : *Parent, *Upper, nUpper, nUpperBase (위 행 Run과 Parent 인덱스 보정), *Lower, nLower, nLowerBase (아래 행), nConnectivity
+ * @Output : *Parent
+ */
+void UnionOverlapRuns(int* Parent, RUN* Upper, int nUpper, int nUpperBase, RUN* Lower, int nLower, int nLowerBase, int nConnectivity)
+{
+	int nGap = (8 == nConnectivity) ? 1 : 0;
+	int i = 0, j = 0;
+
+	// 두 행의 Run은 열 순서로 정렬되어 있으므로 두 포인터로 겹침 검사
+	while (i < nUpper && j < nLower) {
+		if (Upper[i].nStart < Lower[j].nEnd + nGap && Lower[j].nStart < Upper[i].nEnd + nGap)
+			UnionRoot(Parent, nUpperBase + i, nLowerBase + j);
+
+		if (Upper[i].nEnd < Lower[j].nEnd)
+			i++;
+		else
+			j++;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : LabelBand
+ * @Descriotion : 1 pass - 행 띠 안에서 Run을 추출하고 바로 위 행의 Run과 Union (띠 내부 인덱스 사용)
+ *                16픽셀 단위 비교로 배경/전경 구간을 건너뜀
+ * @Input : *pParam (CCL_PARAM*), nBand, nStartRow, nEndRow
+ * @Output : Runs[nBand], Parent[nBand], nRuns[nBand]
+ */
+void LabelBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	CCL_PARAM* p = (CCL_PARAM*)pParam;
+	int nCap = 1024, nCount = 0;
+	int nPrevStart = 0, nPrevCount = 0;
+	RUN* Runs = (RUN*)malloc(sizeof(RUN) * nCap);
+	int* Parent = (int*)malloc(sizeof(int) * nCap);
+
+	for (int i = nStartRow; i < nEndRow && NULL != Runs && NULL != Parent; i++) {
+		BYTE* pRow = &p->Input[i * p->nWidth];
+		int nRowStart = nCount;
+		int j = 0;
+
+		while (j < p->nWidth) {
+			// 배경 건너뛰기
+			while (j + 16 <= p->nWidth && 0 == ThresholdMask16(&pRow[j], 1))
+				j += 16;
+			while (j < p->nWidth && 0 == pRow[j])
+				j++;
+			if (j >= p->nWidth)
+				break;
+
+			int nStart = j;
+
+			// 전경 건너뛰기
+			while (j + 16 <= p->nWidth && 0xFFFF == ThresholdMask16(&pRow[j], 1))
+				j += 16;
+			while (j < p->nWidth && 0 != pRow[j])
+				j++;
+
+			if (nCount == nCap) {
+				RUN* pNewRuns = (RUN*)realloc(Runs, sizeof(RUN) * nCap * 2);
+				int* pNewParent = (int*)realloc(Parent, sizeof(int) * nCap * 2);
+
+				if (NULL != pNewRuns)
+					Runs = pNewRuns;
+				if (NULL != pNewParent)
+					Parent = pNewParent;
+				if (NULL == pNewRuns || NULL == pNewParent) {
+					p->nError = 1;
+					break;
+				}
+				nCap *= 2;
+			}
+
+			Runs[nCount].nRow = i;
+			Runs[nCount].nStart = nStart;
+			Runs[nCount].nEnd = j;
+			Parent[nCount] = nCount;
+			nCount++;
+		}
+
+		// 띠의 첫 행은 위 행과의 연결을 경계 병합 단계에서 처리
+		if (i > nStartRow)
+			UnionOverlapRuns(Parent, &Runs[nPrevStart], nPrevCount, nPrevStart, &Runs[nRowStart], nCount - nRowStart, nRowStart, p->nConnectivity);
+
+		nPrevStart = nRowStart;
+		nPrevCount = nCount - nRowStart;
+	}
+
+	if (NULL == Runs || NULL == Parent)
+		p->nError = 1;
+
+	p->Runs[nBand] = Runs;
+	p->Parent[nBand] = Parent;
+	p->nRuns[nBand] = nCount;
+
+	return;
+}
+
+/*
+ * @Function Name : FillLabelBand
+ * @Descriotion : 2 pass - 행 띠의 Run별 최종 Label을 Label 영상에 기록 (배경 0)
+ * @Input : *pParam (CCL_PARAM*), nBand, nStartRow, nEndRow
+ * @Output : Labels
+ */
+void FillLabelBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	CCL_PARAM* p = (CCL_PARAM*)pParam;
+
+	memset(&p->Labels[nStartRow * p->nWidth], 0, sizeof(int) * (nEndRow - nStartRow) * p->nWidth);
+
+	for (int i = 0; i < p->nRuns[nBand]; i++) {
+		RUN* pRun = &p->Runs[nBand][i];
+		int nLabel = p->RunLabel[p->nOffset[nBand] + i];
+
+		for (int x = pRun->nStart; x < pRun->nEnd; x++)
+			p->Labels[pRun->nRow * p->nWidth + x] = nLabel;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : LabelConnectedComponentsBands
+ * @Descriotion : 이진 영상(0 배경, 0이 아닌 값 전경)을 복사 없이 그대로 사용하는 Run 기반 2-pass Union-Find Labeling
+ *                1. 행 띠별 병렬 Run 추출/Union  2. 띠 경계 행의 Run 병합  3. Run 단위로 Label 확정과 동시에 통계 계산
+ *                Label은 래스터 순서로 처음 나타나는 Run 순으로 붙으므로 띠 수와 관계없이 같음
+ * @Input : *Input, nWidth, nHeight, nConnectivity(4 또는 8), *Labels(NULL이면 Label 영상 생략), nBands(1 ~ MAX_THREADS, nHeight 이하)
+ * @Output : *Labels, **ppStats(Component 수만큼 할당, 호출자가 free), Component 수 (실패 -1)
+ */
+int LabelConnectedComponentsBands(BYTE* Input, int nWidth, int nHeight, int nConnectivity, int* Labels, BLOB_STATS** ppStats, int nBands)
+{
+	CCL_PARAM Param;
+	int nTotal = 0, nComponents = 0;
+	int* GlobalParent = NULL;
+	BLOB_STATS* Stats = NULL;
+
+	memset(&Param, 0, sizeof(Param));
+	Param.Input = Input;
+	Param.Labels = Labels;
+	Param.nWidth = nWidth;
+	Param.nConnectivity = nConnectivity;
+	*ppStats = NULL;
+
+	// 1. 행 띠별 Run 추출 및 띠 내부 Union
+	RunBands(LabelBand, &Param, nHeight, nBands);
+
+	for (int b = 0; b < nBands; b++) {
+		Param.nOffset[b] = nTotal;
+		nTotal += Param.nRuns[b];
+	}
+
+	GlobalParent = (int*)malloc(sizeof(int) * (nTotal + 1));
+	Param.RunLabel = (int*)malloc(sizeof(int) * (nTotal + 1));
+
+	if (Param.nError || NULL == GlobalParent || NULL == Param.RunLabel) {
+		nComponents = -1;
+		goto CLEANUP;
+	}
+
+	// 2. 띠 내부 부모 인덱스를 전체 인덱스로 변환하고, 띠 경계의 위/아래 행 Run을 병합
+	for (int b = 0; b < nBands; b++)
+		for (int i = 0; i < Param.nRuns[b]; i++)
+			GlobalParent[Param.nOffset[b] + i] = Param.nOffset[b] + Param.Parent[b][i];
+
+	for (int b = 1; b < nBands; b++) {
+		int nBorderRow = (int)((long long)nHeight * b / nBands);	// b번 띠의 첫 행
+		int nUpper = Param.nRuns[b - 1], nLower = 0;
+		int nUpperCount = 0;
+
+		while (nUpper > 0 && Param.Runs[b - 1][nUpper - 1].nRow == nBorderRow - 1) {
+			nUpper--;
+			nUpperCount++;
+		}
+		while (nLower < Param.nRuns[b] && Param.Runs[b][nLower].nRow == nBorderRow)
+			nLower++;
+
+		UnionOverlapRuns(GlobalParent, &Param.Runs[b - 1][nUpper], nUpperCount, Param.nOffset[b - 1] + nUpper,
+			Param.Runs[b], nLower, Param.nOffset[b], nConnectivity);
+	}
+
+	// 3. 루트는 항상 더 작은 인덱스이므로 순방향 한 번으로 Label 확정
+	for (int i = 0; i < nTotal; i++) {
+		int nRoot = FindRoot(GlobalParent, i);
+
+		if (nRoot == i)
+			Param.RunLabel[i] = ++nComponents;
+		else
+			Param.RunLabel[i] = Param.RunLabel[nRoot];
+	}
+
+	Stats = (BLOB_STATS*)calloc(nComponents + 1, sizeof(BLOB_STATS));
+	if (NULL == Stats) {
+		nComponents = -1;
+		goto CLEANUP;
+	}
+
+	// Run 단위로 면적, Bounding Box, 좌표 합을 누적
+	for (int b = 0; b < nBands; b++) {
+		for (int i = 0; i < Param.nRuns[b]; i++) {
+			RUN* pRun = &Param.Runs[b][i];
+			BLOB_STATS* pStat = &Stats[Param.RunLabel[Param.nOffset[b] + i] - 1];
+			int nLength = pRun->nEnd - pRun->nStart;
+
+			if (0 == pStat->nArea) {
+				pStat->nLeft = pRun->nStart;
+				pStat->nRight = pRun->nEnd - 1;
+				pStat->nTop = pStat->nBottom = pRun->nRow;
+			}
+			else {
+				if (pRun->nStart < pStat->nLeft) pStat->nLeft = pRun->nStart;
+				if (pRun->nEnd - 1 > pStat->nRight) pStat->nRight = pRun->nEnd - 1;
+				if (pRun->nRow > pStat->nBottom) pStat->nBottom = pRun->nRow;
+			}
+
+			pStat->nArea += nLength;
+			pStat->dCenterX += (pRun->nStart + pRun->nEnd - 1) * 0.5 * nLength;
+			pStat->dCenterY += (double)pRun->nRow * nLength;
+		}
+	}
+
+	for (int i = 0; i < nComponents; i++) {
+		Stats[i].dCenterX /= Stats[i].nArea;
+		Stats[i].dCenterY /= Stats[i].nArea;
+	}
+
+	if (NULL != Labels)
+		RunBands(FillLabelBand, &Param, nHeight, nBands);
+
+	*ppStats = Stats;
+
+CLEANUP:
+	for (int b = 0; b < nBands; b++) {
+		free(Param.Runs[b]);
+		free(Param.Parent[b]);
+	}
+	free(GlobalParent);
+	free(Param.RunLabel);
+
+	return nComponents;
+}
+
+/*
+ * @Function Name : LabelConnectedComponents
+ * @Descriotion : 띠 하나가 최소 64행이 되도록 나누어 LabelConnectedComponentsBands 수행
+ * @Input : *Input, nWidth, nHeight, nConnectivity(4 또는 8), *Labels(NULL이면 Label 영상 생략)
+ * @Output : *Labels, **ppStats(Component 수만큼 할당, 호출자가 free), Component 수 (실패 -1)
+ */
+int LabelConnectedComponents(BYTE* Input, int nWidth, int nHeight, int nConnectivity, int* Labels, BLOB_STATS** ppStats)
+{
+	PROFILE_BEGIN();
+
+	int nComponents = LabelConnectedComponentsBands(Input, nWidth, nHeight, nConnectivity, Labels, ppStats, GetBandCount(nHeight, 64));
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, (NULL != Labels ? sizeof(int) * nWidth * nHeight : 0) + sizeof(BLOB_STATS) * (nComponents > 0 ? nComponents : 0));
+
+	return nComponents;
+}
+
+/*
+ * ver 1.2 : Strided Pooling, Gaussian Pyramid
+ * k x k 창을 k 간격으로 이동하는 다운샘플링 (MinPooling / MaxPooling / MedianPooling 확장)과
+ * Burt-Adelson [1 4 6 4 1] / 16 Kernel의 Gaussian Pyramid Reduce / Expand
+ */
+
+#define POOL_MIN		1
+#define POOL_MAX		2
+#define POOL_MEAN		3
+#define POOL_MEDIAN		4
+
+#define MAX_PYRAMID_LEVELS	16
+
+/*
+ * @Function Name : PoolWindow
+ * @Descriotion : k x k 창 하나를 MinPooling / MaxPooling / MedianPooling 또는 평균으로 축약 (Scalar 경로, 오른쪽 끝 처리용)
+ * @Input : *Input, nWidth, x, y(창의 좌상단), nK, nType
+ * @Output : 축약된 값
+ */
+BYTE PoolWindow(BYTE* Input, int nWidth, int x, int y, int nK, int nType)
+{
+	BYTE bArr[9];
+	int nSum = 0;
+
+	for (int m = 0; m < nK; m++) {
+		for (int n = 0; n < nK; n++) {
+			bArr[m * nK + n] = Input[(y + m) * nWidth + (x + n)];
+			nSum += bArr[m * nK + n];
+		}
+	}
+
+	switch (nType) {
+	case POOL_MIN:		return MinPooling(bArr, nK * nK);
+	case POOL_MAX:		return MaxPooling(bArr, nK * nK);
+	case POOL_MEDIAN:	return MedianPooling(bArr, nK * nK);
+	default:			return (BYTE)((nSum + nK * nK / 2) / (nK * nK));
+	}
+}
+
+/*
+ * @Function Name : Pool2x2Row
+ * @Descriotion : 연속된 입력 2개 행을 2x2, 간격 2로 축약하여 출력 1개 행을 생성
+ *                SSE2 : 16열을 읽어 세로 min/max 후 짝/홀 열을 16비트로 분리하여 8개 출력
+ *                2x2 중앙값은 MedianPooling과 같은 위쪽 중앙값(정렬 후 [2]) = max(min(세로 max 2개), max(세로 min 2개))
+ * @Input : *pRow(첫 행), nWidth, nOutWidth, nType
+ * @Output : *pOut
+ */
+void Pool2x2Row(BYTE* pRow, BYTE* pOut, int nWidth, int nOutWidth, int nType)
+{
+	int x = 0;
+
+#ifdef USE_SSE2
+	__m128i vLowMask = _mm_set1_epi16(0x00FF);
+	__m128i vTwo = _mm_set1_epi16(2);
+
+	for (; x + 8 <= nOutWidth; x += 8) {
+		__m128i v0 = _mm_loadu_si128((__m128i*)&pRow[2 * x]);
+		__m128i v1 = _mm_loadu_si128((__m128i*)&pRow[nWidth + 2 * x]);
+		__m128i vMin = _mm_min_epu8(v0, v1);
+		__m128i vMax = _mm_max_epu8(v0, v1);
+		__m128i vResult;
+
+		switch (nType) {
+		case POOL_MIN:
+			vResult = _mm_min_epi16(_mm_and_si128(vMin, vLowMask), _mm_srli_epi16(vMin, 8));
+			break;
+		case POOL_MAX:
+			vResult = _mm_max_epi16(_mm_and_si128(vMax, vLowMask), _mm_srli_epi16(vMax, 8));
+			break;
+		case POOL_MEDIAN:
+			vResult = _mm_max_epi16(
+				_mm_min_epi16(_mm_and_si128(vMax, vLowMask), _mm_srli_epi16(vMax, 8)),
+				_mm_max_epi16(_mm_and_si128(vMin, vLowMask), _mm_srli_epi16(vMin, 8)));
+			break;
+		default:
+			// (a + b + c + d + 2) / 4
+			vResult = _mm_add_epi16(_mm_add_epi16(_mm_and_si128(v0, vLowMask), _mm_srli_epi16(v0, 8)),
+				_mm_add_epi16(_mm_and_si128(v1, vLowMask), _mm_srli_epi16(v1, 8)));
+			vResult = _mm_srli_epi16(_mm_add_epi16(vResult, vTwo), 2);
+			break;
+		}
+
+		_mm_storel_epi64((__m128i*)&pOut[x], _mm_packus_epi16(vResult, vResult));
+	}
+#endif
+
+	// 나머지 열 (SSE2가 없으면 전체)
+	for (; x < nOutWidth; x++)
+		pOut[x] = PoolWindow(pRow, nWidth, 2 * x, 0, 2, nType);
+
+	return;
+}
+
+/*
+ * @Function Name : Median3
+ * @Descriotion : 세 값의 중앙값
+ * @Input : a, b, c
+ * @Output : 중앙값
+ */
+BYTE Median3(BYTE a, BYTE b, BYTE c)
+{
+	BYTE bLow = a < b ? a : b;
+	BYTE bHigh = a < b ? b : a;
+
+	return c < bLow ? bLow : (c > bHigh ? bHigh : c);
+}
+
+/*
+ * @Function Name : Pool3x3Row
+ * @Descriotion : 연속된 입력 3개 행을 3x3, 간격 3으로 축약하여 출력 1개 행을 생성
+ *                1. 세로 방향(SSE2) : 각 열의 3개 값을 정렬하여 Low / Mid / High, 16비트 합계
+ *                2. 가로 방향 : 최소 = min(Low), 최대 = max(High), 평균 = 합 / 9,
+ *                   중앙값 = Median3(max(Low), Median3(Mid), min(High)) (9개 정렬 없이 MedianPooling과 같은 결과)
+ * @Input : *pRow(첫 행), nWidth, nOutWidth, nType, *Low, *Mid, *High, *Sum (nWidth 크기 작업 버퍼)
+ * @Output : *pOut
+ */
+void Pool3x3Row(BYTE* pRow, BYTE* pOut, int nWidth, int nOutWidth, int nType, BYTE* Low, BYTE* Mid, BYTE* High, WORD* Sum)
+{
+	BYTE* pRow0 = pRow;
+	BYTE* pRow1 = pRow + nWidth;
+	BYTE* pRow2 = pRow + nWidth * 2;
+	int nCols = nOutWidth * 3;
+	int x = 0;
+
+#ifdef USE_SSE2
+	__m128i vZero = _mm_setzero_si128();
+
+	for (; x + 16 <= nCols; x += 16) {
+		__m128i a = _mm_loadu_si128((__m128i*)&pRow0[x]);
+		__m128i b = _mm_loadu_si128((__m128i*)&pRow1[x]);
+		__m128i c = _mm_loadu_si128((__m128i*)&pRow2[x]);
+		__m128i vMinAB = _mm_min_epu8(a, b);
+		__m128i vMaxAB = _mm_max_epu8(a, b);
+
+		_mm_storeu_si128((__m128i*)&Low[x], _mm_min_epu8(vMinAB, c));
+		_mm_storeu_si128((__m128i*)&High[x], _mm_max_epu8(vMaxAB, c));
+		_mm_storeu_si128((__m128i*)&Mid[x], _mm_max_epu8(vMinAB, _mm_min_epu8(vMaxAB, c)));
+
+		if (POOL_MEAN == nType) {
+			__m128i vLo = _mm_add_epi16(_mm_add_epi16(_mm_unpacklo_epi8(a, vZero), _mm_unpacklo_epi8(b, vZero)), _mm_unpacklo_epi8(c, vZero));
+			__m128i vHi = _mm_add_epi16(_mm_add_epi16(_mm_unpackhi_epi8(a, vZero), _mm_unpackhi_epi8(b, vZero)), _mm_unpackhi_epi8(c, vZero));
+
+			_mm_storeu_si128((__m128i*)&Sum[x], vLo);
+			_mm_storeu_si128((__m128i*)&Sum[x + 8], vHi);
+		}
+	}
+#endif
+
+	for (; x < nCols; x++) {
+		BYTE a = pRow0[x], b = pRow1[x], c = pRow2[x];
+		BYTE bMinAB = a < b ? a : b;
+		BYTE bMaxAB = a < b ? b : a;
+
+		Low[x] = bMinAB < c ? bMinAB : c;
+		High[x] = bMaxAB > c ? bMaxAB : c;
+		Mid[x] = Median3(a, b, c);
+		Sum[x] = (WORD)(a + b + c);
+	}
+
+	for (x = 0; x < nOutWidth; x++) {
+		BYTE* pLow = &Low[3 * x];
+		BYTE* pMid = &Mid[3 * x];
+		BYTE* pHigh = &High[3 * x];
+		BYTE bMaxLow, bMinHigh;
+
+		bMaxLow = pLow[0] > pLow[1] ? pLow[0] : pLow[1];
+		bMaxLow = bMaxLow > pLow[2] ? bMaxLow : pLow[2];
+		bMinHigh = pHigh[0] < pHigh[1] ? pHigh[0] : pHigh[1];
+		bMinHigh = bMinHigh < pHigh[2] ? bMinHigh : pHigh[2];
+
+		switch (nType) {
+		case POOL_MIN:
+			pOut[x] = pLow[0] < pLow[1] ? (pLow[0] < pLow[2] ? pLow[0] : pLow[2]) : (pLow[1] < pLow[2] ? pLow[1] : pLow[2]);
+			break;
+		case POOL_MAX:
+			pOut[x] = pHigh[0] > pHigh[1] ? (pHigh[0] > pHigh[2] ? pHigh[0] : pHigh[2]) : (pHigh[1] > pHigh[2] ? pHigh[1] : pHigh[2]);
+			break;
+		case POOL_MEDIAN:
+			pOut[x] = Median3(bMaxLow, Median3(pMid[0], pMid[1], pMid[2]), bMinHigh);
+			break;
+		default:
+			pOut[x] = (BYTE)((Sum[3 * x] + Sum[3 * x + 1] + Sum[3 * x + 2] + 4) / 9);
+			break;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : StridedPooling
+ * @Descriotion : k x k (k = 2, 3) 창을 k 간격으로 적용하는 Min / Max / Mean / Median 다운샘플링
+ *                출력 크기는 (nWidth / k) x (nHeight / k), 남는 행/열은 버림
+ * @Input : *Input, nWidth, nHeight, nK, nType(POOL_MIN, POOL_MAX, POOL_MEAN, POOL_MEDIAN)
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int StridedPooling(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nK, int nType)
+{
+	PROFILE_BEGIN();
+
+	int nOutWidth = 0, nOutHeight = 0;
+	int nResult = 0;
+	BYTE* Buffer = NULL;
+
+	if (2 != nK && 3 != nK)
+		goto CLEANUP;
+
+	nOutWidth = nWidth / nK;
+	nOutHeight = nHeight / nK;
+
+	if (2 == nK) {
+		for (int y = 0; y < nOutHeight; y++)
+			Pool2x2Row(&Input[2 * y * nWidth], &Output[y * nOutWidth], nWidth, nOutWidth, nType);
+
+		nResult = 1;
+		goto CLEANUP;
+	}
+
+	// 3x3은 세로 정렬 결과를 담을 행 버퍼 사용
+	Buffer = (BYTE*)malloc(nWidth * 3 + sizeof(WORD) * nWidth);
+	if (NULL == Buffer)
+		goto CLEANUP;
+
+	for (int y = 0; y < nOutHeight; y++)
+		Pool3x3Row(&Input[3 * y * nWidth], &Output[y * nOutWidth], nWidth, nOutWidth, nType,
+			Buffer, Buffer + nWidth, Buffer + nWidth * 2, (WORD*)(Buffer + nWidth * 3));
+
+	nResult = 1;
+
+CLEANUP:
+	free(Buffer);
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nOutWidth * nOutHeight);
+
+	return nResult;
+}
+
+// Gaussian Pyramid : Level[0]은 원본(외부 버퍼), Level[1 ~ nLevels-1]은 이전 Level의 1/2 크기
+typedef struct {
+	int nLevels;
+	int nWidth[MAX_PYRAMID_LEVELS];
+	int nHeight[MAX_PYRAMID_LEVELS];
+	BYTE* Level[MAX_PYRAMID_LEVELS];
+	int nReadyRows[MAX_PYRAMID_LEVELS];		// Level별 완성된 행 수 (스트리밍 진행 상태)
+	WORD* VertSum;							// 세로 5-tap 결과 작업 행 (원본 폭)
+} IMAGE_PYRAMID;
+
+/*
+ * @Function Name : ReduceRow
+ * @Descriotion : Pyramid Reduce 한 행 - 세로 [1 4 6 4 1] (SSE2, 16비트) 후 가로 [1 4 6 4 1]을 짝수 열에서만 계산, /256
+ *                경계는 가장자리 행/열 복제
+ * @Input : *Src, nWidth, nHeight, y(출력 행), *VertSum
+ * @Output : *pOut (nWidth / 2 크기)
+ */
+void ReduceRow(BYTE* Src, int nWidth, int nHeight, int y, BYTE* pOut, WORD* VertSum)
+{
+	BYTE* pRows[5];
+	int nOutWidth = nWidth / 2;
+	int x = 0;
+
+	for (int m = 0; m < 5; m++) {
+		int nRow = 2 * y + m - 2;
+		nRow = nRow < 0 ? 0 : (nRow > nHeight - 1 ? nHeight - 1 : nRow);
+		pRows[m] = &Src[nRow * nWidth];
+	}
+
+#ifdef USE_SSE2
+	__m128i vZero = _mm_setzero_si128();
+
+	for (; x + 8 <= nWidth; x += 8) {
+		__m128i v0 = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pRows[0][x]), vZero);
+		__m128i v1 = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pRows[1][x]), vZero);
+		__m128i v2 = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pRows[2][x]), vZero);
+		__m128i v3 = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pRows[3][x]), vZero);
+		__m128i v4 = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pRows[4][x]), vZero);
+
+		// v0 + 4(v1 + v3) + 6 v2 + v4 = v0 + v4 + 4(v1 + v2 + v3) + 2 v2
+		__m128i vSum = _mm_add_epi16(_mm_add_epi16(v0, v4),
+			_mm_add_epi16(_mm_slli_epi16(_mm_add_epi16(_mm_add_epi16(v1, v2), v3), 2), _mm_slli_epi16(v2, 1)));
+
+		_mm_storeu_si128((__m128i*)&VertSum[x], vSum);
+	}
+#endif
+
+	for (; x < nWidth; x++)
+		VertSum[x] = (WORD)(pRows[0][x] + 4 * pRows[1][x] + 6 * pRows[2][x] + 4 * pRows[3][x] + pRows[4][x]);
+
+	for (x = 0; x < nOutWidth; x++) {
+		int c = 2 * x;
+		int l2 = c - 2 < 0 ? 0 : c - 2;
+		int l1 = c - 1 < 0 ? 0 : c - 1;
+		int r1 = c + 1 > nWidth - 1 ? nWidth - 1 : c + 1;
+		int r2 = c + 2 > nWidth - 1 ? nWidth - 1 : c + 2;
+
+		pOut[x] = (BYTE)((VertSum[l2] + 4 * VertSum[l1] + 6 * VertSum[c] + 4 * VertSum[r1] + VertSum[r2] + 128) >> 8);
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : AdvancePyramid
+ * @Descriotion : nLevel의 완성된 행으로 계산 가능한 상위 Level 행을 즉시 계산 (재귀적으로 다음 Level까지 진행)
+ *                상위 행 y는 하위 행 2y+2까지 필요하므로 행이 캐시에 남아 있을 때 바로 사용
+ * @Input : *Pyramid, nLevel
+ * @Output : *Pyramid
+ */
+void AdvancePyramid(IMAGE_PYRAMID* Pyramid, int nLevel)
+{
+	int nNext = nLevel + 1;
+
+	if (nNext >= Pyramid->nLevels)
+		return;
+
+	while (Pyramid->nReadyRows[nNext] < Pyramid->nHeight[nNext]) {
+		int y = Pyramid->nReadyRows[nNext];
+		int nNeed = 2 * y + 2 > Pyramid->nHeight[nLevel] - 1 ? Pyramid->nHeight[nLevel] - 1 : 2 * y + 2;
+
+		if (nNeed >= Pyramid->nReadyRows[nLevel])
+			break;
+
+		ReduceRow(Pyramid->Level[nLevel], Pyramid->nWidth[nLevel], Pyramid->nHeight[nLevel], y,
+			&Pyramid->Level[nNext][y * Pyramid->nWidth[nNext]], Pyramid->VertSum);
+		Pyramid->nReadyRows[nNext]++;
+
+		AdvancePyramid(Pyramid, nNext);
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : DestroyGaussianPyramid
+ * @Descriotion : BuildGaussianPyramid에서 할당한 Level(1 ~)과 작업 버퍼 해제
+ * @Input : *Pyramid
+ * @Output :
+ */
+void DestroyGaussianPyramid(IMAGE_PYRAMID* Pyramid)
+{
+	for (int l = 1; l < Pyramid->nLevels; l++)
+		free(Pyramid->Level[l]);
+	free(Pyramid->VertSum);
+
+	memset(Pyramid, 0, sizeof(IMAGE_PYRAMID));
+
+	return;
+}
+
+/*
+ * @Function Name : BuildGaussianPyramid
+ * @Descriotion : 원본을 한 번 스트리밍하면서 모든 Level을 동시에 생성 (Level 크기가 1보다 작아지면 중단)
+ * @Input : *Input, nWidth, nHeight, nLevels(원본 포함)
+ * @Output : *Pyramid, 성공 1, 실패 0
+ */
+int BuildGaussianPyramid(BYTE* Input, int nWidth, int nHeight, int nLevels, IMAGE_PYRAMID* Pyramid)
+{
+	PROFILE_BEGIN();
+
+	int nResult = 0;
+
+	memset(Pyramid, 0, sizeof(IMAGE_PYRAMID));
+
+	if (nLevels > MAX_PYRAMID_LEVELS)
+		nLevels = MAX_PYRAMID_LEVELS;
+
+	Pyramid->nLevels = 1;
+	Pyramid->nWidth[0] = nWidth;
+	Pyramid->nHeight[0] = nHeight;
+	Pyramid->Level[0] = Input;
+
+	for (int l = 1; l < nLevels; l++) {
+		if (Pyramid->nWidth[l - 1] / 2 < 1 || Pyramid->nHeight[l - 1] / 2 < 1)
+			break;
+
+		Pyramid->nWidth[l] = Pyramid->nWidth[l - 1] / 2;
+		Pyramid->nHeight[l] = Pyramid->nHeight[l - 1] / 2;
+		Pyramid->Level[l] = (BYTE*)malloc(Pyramid->nWidth[l] * Pyramid->nHeight[l]);
+
+		if (NULL == Pyramid->Level[l])
+			break;
+		Pyramid->nLevels++;
+	}
+
+	Pyramid->VertSum = (WORD*)malloc(sizeof(WORD) * nWidth);
+	if (NULL == Pyramid->VertSum) {
+		DestroyGaussianPyramid(Pyramid);
+		goto CLEANUP;
+	}
+
+	// 원본 행을 하나씩 완성된 것으로 표시하며 상위 Level을 연쇄적으로 계산
+	for (int y = 0; y < nHeight; y++) {
+		Pyramid->nReadyRows[0] = y + 1;
+		AdvancePyramid(Pyramid, 0);
+	}
+
+	nResult = 1;
+
+CLEANUP:
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight / 3);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : PyramidExpand
+ * @Descriotion : Pyramid Expand - 2배 업샘플링 후 [1 4 6 4 1] / 16 보간 (짝수 위치 (1 6 1) / 8, 홀수 위치 (4 4) / 8)
+ *                세로 방향은 SSE2 16비트로 계산
+ * @Input : *Input, nWidth, nHeight, nOutWidth, nOutHeight (2 * nWidth 이하, 2 * nHeight 이하)
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int PyramidExpand(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nOutWidth, int nOutHeight)
+{
+	PROFILE_BEGIN();
+
+	int nResult = 0;
+	WORD* VertSum = (WORD*)malloc(sizeof(WORD) * (nWidth + 1));
+	if (NULL == VertSum)
+		goto CLEANUP;
+
+	for (int y = 0; y < nOutHeight; y++) {
+		int c = y / 2 > nHeight - 1 ? nHeight - 1 : y / 2;		// 홀수 출력 크기의 마지막 행
+		int u = c - 1 < 0 ? 0 : c - 1;
+		int d = c + 1 > nHeight - 1 ? nHeight - 1 : c + 1;
+		BYTE* pUp = &Input[u * nWidth];
+		BYTE* pCenter = &Input[c * nWidth];
+		BYTE* pDown = &Input[d * nWidth];
+		int x = 0;
+
+		// 세로 : 짝수 행 (1 6 1), 홀수 행 (0 4 4), 결과는 8배
+#ifdef USE_SSE2
+		__m128i vZero = _mm_setzero_si128();
+
+		for (; x + 8 <= nWidth; x += 8) {
+			__m128i vU = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pUp[x]), vZero);
+			__m128i vC = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pCenter[x]), vZero);
+			__m128i vD = _mm_unpacklo_epi8(_mm_loadl_epi64((__m128i*)&pDown[x]), vZero);
+			__m128i vSum;
+
+			if (0 == (y & 1))
+				vSum = _mm_add_epi16(_mm_add_epi16(vU, vD), _mm_add_epi16(_mm_slli_epi16(vC, 2), _mm_slli_epi16(vC, 1)));
+			else
+				vSum = _mm_slli_epi16(_mm_add_epi16(vC, vD), 2);
+
+			_mm_storeu_si128((__m128i*)&VertSum[x], vSum);
+		}
+#endif
+
+		for (; x < nWidth; x++) {
+			if (0 == (y & 1))
+				VertSum[x] = (WORD)(pUp[x] + 6 * pCenter[x] + pDown[x]);
+			else
+				VertSum[x] = (WORD)(4 * (pCenter[x] + pDown[x]));
+		}
+		VertSum[nWidth] = VertSum[nWidth - 1];		// 오른쪽 경계 복제
+
+		// 가로 : 같은 규칙, 결과는 64배
+		for (x = 0; x < nOutWidth; x++) {
+			int cx = x / 2 > nWidth - 1 ? nWidth - 1 : x / 2;
+			int nSum;
+
+			if (0 == (x & 1))
+				nSum = VertSum[cx - 1 < 0 ? 0 : cx - 1] + 6 * VertSum[cx] + VertSum[cx + 1];
+			else
+				nSum = 4 * (VertSum[cx] + VertSum[cx + 1]);
+
+			Output[y * nOutWidth + x] = (BYTE)((nSum + 32) >> 6);
+		}
+	}
+
+	nResult = 1;
+
+CLEANUP:
+	free(VertSum);
+
+	PROFILE_END(nOutWidth * nOutHeight, nWidth * nHeight, nOutWidth * nOutHeight);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : PadRows
+ * @Descriotion : 행 사이 여백 없이 저장된 영상을 BMP 행 크기(4바이트 정렬)로 제자리 변환 (버퍼는 변환 후 크기 이상)
+ * @Input : *Buffer, nWidth, nHeight
+ * @Output : *Buffer, 변환 후 데이터 크기
+ */
+int PadRows(BYTE* Buffer, int nWidth, int nHeight)
+{
+	int nStride = (nWidth + 3) / 4 * 4;
+
+	// 뒤쪽 행부터 이동해야 덮어쓰지 않음
+	for (int y = nHeight - 1; y >= 0; y--) {
+		memmove(&Buffer[y * nStride], &Buffer[y * nWidth], nWidth);
+		memset(&Buffer[y * nStride + nWidth], 0, nStride - nWidth);
+	}
+
+	return nStride * nHeight;
+}
+
+/*
+ * ver 1.3 : Resize (Nearest / Bilinear / Area)
+ * 고정소수점 계수 표를 미리 계산하고 가로(원본 행 -> Q7 16비트 중간 행), 세로(중간 행 -> 출력 행) 순으로 분리 처리
+ * 출력 행 띠 단위로 다중 스레드 수행
+ */
+
+#define RESIZE_NEAREST		1
+#define RESIZE_BILINEAR		2
+#define RESIZE_AREA			3
+
+#define RESIZE_WEIGHT_BITS	14		// 계수 고정소수점 비트 (Q14)
+#define RESIZE_INTER_BITS	7		// 가로 처리 결과(중간 행) 고정소수점 비트 (Q7, 최대 255 x 128 = 32640)
+
+// 출력 좌표별 원본 좌표와 가중치 표
+typedef struct {
+	int nTaps;			// 출력 픽셀당 Tap 수 (Nearest 1, 그 외 SSE2 madd를 위해 짝수)
+	int* Index;			// [출력 크기 x nTaps] 원본 좌표 (경계 안으로 제한)
+	short* Weight;		// [출력 크기 x nTaps] Q14 가중치, 합계 1 << 14
+} RESIZE_TABLE;
+
+// 행 띠별 Resize 작업 데이터
+typedef struct {
+	BYTE* Input;
+	BYTE* Output;
+	int nWidth, nHeight;
+	int nOutWidth, nOutHeight;
+	int nMode;
+	RESIZE_TABLE* TableX;
+	RESIZE_TABLE* TableY;
+	int nError;
+} RESIZE_PARAM;
+
+/*
+ * @Function Name : BuildResizeTable
+ * @Descriotion : 한 축의 Resize 계수 표 생성
+ *                Bilinear : 원본 좌표 (x + 0.5) * scale - 0.5 의 이웃 2개
+ *                Area : 출력 픽셀이 덮는 원본 구간 [x * scale, (x + 1) * scale) 과 겹치는 길이에 비례
+ * @Input : nSrc, nDst, nMode
+ * @Output : *Table, 성공 1, 실패 0
+ */
+int BuildResizeTable(RESIZE_TABLE* Table, int nSrc, int nDst, int nMode)
+{
+	double dScale = (double)nSrc / nDst;
+	int nTaps;
+
+	if (RESIZE_NEAREST == nMode)
+		nTaps = 1;
+	else if (RESIZE_BILINEAR == nMode)
+		nTaps = 2;
+	else
+		nTaps = ((int)ceil(dScale) + 2) & ~1;	// 구간이 걸칠 수 있는 최대 픽셀 수를 짝수로
+
+	Table->nTaps = nTaps;
+	Table->Index = (int*)malloc(sizeof(int) * nDst * nTaps);
+	Table->Weight = (short*)malloc(sizeof(short) * nDst * nTaps);
+
+	if (NULL == Table->Index || NULL == Table->Weight) {
+		free(Table->Index);
+		free(Table->Weight);
+		Table->Index = NULL;
+		Table->Weight = NULL;
+		return 0;
+	}
+
+	for (int x = 0; x < nDst; x++) {
+		int* pIndex = &Table->Index[x * nTaps];
+		short* pWeight = &Table->Weight[x * nTaps];
+		double dWeight[64] = { 0.0, };
+		int nFirst, nSum = 0, nMax = 0;
+
+		if (RESIZE_NEAREST == nMode) {
+			int nSrcX = (int)((x + 0.5) * dScale);
+			pIndex[0] = nSrcX > nSrc - 1 ? nSrc - 1 : nSrcX;
+			pWeight[0] = 1 << RESIZE_WEIGHT_BITS;
+			continue;
+		}
+
+		if (RESIZE_BILINEAR == nMode) {
+			double dPos = (x + 0.5) * dScale - 0.5;
+
+			if (dPos < 0.0)
+				dPos = 0.0;
+			nFirst = (int)dPos;
+			dWeight[1] = dPos - nFirst;
+			dWeight[0] = 1.0 - dWeight[1];
+		}
+		else {
+			double dStart = x * dScale, dEnd = (x + 1) * dScale;
+
+			nFirst = (int)dStart;
+			for (int k = 0; k < nTaps && k < 64; k++) {
+				double dLow = nFirst + k > dStart ? nFirst + k : dStart;
+				double dHigh = nFirst + k + 1 < dEnd ? nFirst + k + 1 : dEnd;
+
+				if (dHigh > dLow)
+					dWeight[k] = (dHigh - dLow) / dScale;
+			}
+		}
+
+		// Q14 변환 후 반올림 오차는 가장 큰 가중치에 더해 합계를 정확히 1 << 14 로 맞춤
+		for (int k = 0; k < nTaps; k++) {
+			int nIndex = nFirst + k;
+
+			pIndex[k] = nIndex > nSrc - 1 ? nSrc - 1 : nIndex;
+			pWeight[k] = (short)(dWeight[k] * (1 << RESIZE_WEIGHT_BITS) + 0.5);
+			nSum += pWeight[k];
+			if (pWeight[k] > pWeight[nMax])
+				nMax = k;
+		}
+		pWeight[nMax] += (short)((1 << RESIZE_WEIGHT_BITS) - nSum);
+	}
+
+	return 1;
+}
+
+/*
+ * @Function Name : DestroyResizeTable
+ * @Descriotion : BuildResizeTable에서 할당한 표 해제
+ * @Input : *Table
+ * @Output :
+ */
+void DestroyResizeTable(RESIZE_TABLE* Table)
+{
+	free(Table->Index);
+	free(Table->Weight);
+
+	return;
+}
+
+/*
+ * @Function Name : ResizeRowHorizontal
+ * @Descriotion : 원본 한 행을 가로 방향으로 Resize하여 Q7 16비트 중간 행 생성
+ *                SSE2 : 출력 4개씩, Tap 2개를 (원본, 원본) x (가중치, 가중치) 32비트 쌍으로 묶어 madd
+ * @Input : *pSrc, *Table, nOutWidth
+ * @Output : *pInter
+ */
+void ResizeRowHorizontal(BYTE* pSrc, short* pInter, RESIZE_TABLE* Table, int nOutWidth)
+{
+	int nTaps = Table->nTaps;
+	int x = 0;
+
+#ifdef USE_SSE2
+	__m128i vRound = _mm_set1_epi32(1 << (RESIZE_WEIGHT_BITS - RESIZE_INTER_BITS - 1));
+
+	for (; x + 4 <= nOutWidth; x += 4) {
+		__m128i vAcc = _mm_setzero_si128();
+
+		for (int k = 0; k < nTaps; k += 2) {
+			int* i0 = &Table->Index[x * nTaps + k];
+			short* w0 = &Table->Weight[x * nTaps + k];
+
+			__m128i vPixel = _mm_set_epi32(
+				pSrc[i0[3 * nTaps]] | (pSrc[i0[3 * nTaps + 1]] << 16),
+				pSrc[i0[2 * nTaps]] | (pSrc[i0[2 * nTaps + 1]] << 16),
+				pSrc[i0[nTaps]] | (pSrc[i0[nTaps + 1]] << 16),
+				pSrc[i0[0]] | (pSrc[i0[1]] << 16));
+			__m128i vWeight = _mm_set_epi32(
+				(WORD)w0[3 * nTaps] | ((WORD)w0[3 * nTaps + 1] << 16),
+				(WORD)w0[2 * nTaps] | ((WORD)w0[2 * nTaps + 1] << 16),
+				(WORD)w0[nTaps] | ((WORD)w0[nTaps + 1] << 16),
+				(WORD)w0[0] | ((WORD)w0[1] << 16));
+
+			vAcc = _mm_add_epi32(vAcc, _mm_madd_epi16(vPixel, vWeight));
+		}
+
+		vAcc = _mm_srai_epi32(_mm_add_epi32(vAcc, vRound), RESIZE_WEIGHT_BITS - RESIZE_INTER_BITS);
+		_mm_storel_epi64((__m128i*)&pInter[x], _mm_packs_epi32(vAcc, vAcc));
+	}
+#endif
+
+	for (; x < nOutWidth; x++) {
+		int nSum = 0;
+
+		for (int k = 0; k < nTaps; k++)
+			nSum += pSrc[Table->Index[x * nTaps + k]] * Table->Weight[x * nTaps + k];
+
+		pInter[x] = (short)((nSum + (1 << (RESIZE_WEIGHT_BITS - RESIZE_INTER_BITS - 1))) >> (RESIZE_WEIGHT_BITS - RESIZE_INTER_BITS));
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : ResizeRowVertical
+ * @Descriotion : 중간 행 nTaps개를 세로 가중합하여 출력 한 행 생성 (Q7 x Q14 -> >> 21)
+ *                SSE2 : 두 중간 행을 unpack으로 교차 배치하여 madd, 8열씩 처리
+ * @Input : **Rows, *pWeight, nTaps(짝수), nOutWidth
+ * @Output : *pOut
+ */
+void ResizeRowVertical(short** Rows, short* pWeight, int nTaps, BYTE* pOut, int nOutWidth)
+{
+	int nShift = RESIZE_WEIGHT_BITS + RESIZE_INTER_BITS;
+	int x = 0;
+
+#ifdef USE_SSE2
+	__m128i vRound = _mm_set1_epi32(1 << (nShift - 1));
+
+	for (; x + 8 <= nOutWidth; x += 8) {
+		__m128i vLow = _mm_setzero_si128();
+		__m128i vHigh = _mm_setzero_si128();
+
+		for (int k = 0; k < nTaps; k += 2) {
+			__m128i a = _mm_loadu_si128((__m128i*)&Rows[k][x]);
+			__m128i b = _mm_loadu_si128((__m128i*)&Rows[k + 1][x]);
+			__m128i vWeight = _mm_set1_epi32((WORD)pWeight[k] | ((WORD)pWeight[k + 1] << 16));
+
+			vLow = _mm_add_epi32(vLow, _mm_madd_epi16(_mm_unpacklo_epi16(a, b), vWeight));
+			vHigh = _mm_add_epi32(vHigh, _mm_madd_epi16(_mm_unpackhi_epi16(a, b), vWeight));
+		}
+
+		vLow = _mm_srai_epi32(_mm_add_epi32(vLow, vRound), nShift);
+		vHigh = _mm_srai_epi32(_mm_add_epi32(vHigh, vRound), nShift);
+
+		__m128i vPacked = _mm_packs_epi32(vLow, vHigh);
+		_mm_storel_epi64((__m128i*)&pOut[x], _mm_packus_epi16(vPacked, vPacked));
+	}
+#endif
+
+	for (; x < nOutWidth; x++) {
+		int nSum = 0;
+
+		for (int k = 0; k < nTaps; k++)
+			nSum += Rows[k][x] * pWeight[k];
+
+		nSum = (nSum + (1 << (nShift - 1))) >> nShift;
+		pOut[x] = (BYTE)(nSum < 0 ? 0 : (nSum > 255 ? 255 : nSum));
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : ResizeBand
+ * @Descriotion : 출력 행 [nStartRow, nEndRow) 를 생성, 가로 처리한 중간 행은 원본 행 번호로 캐시하여 재사용
+ * @Input : *pParam (RESIZE_PARAM*), nBand, nStartRow, nEndRow
+ * @Output : Output
+ */
+void ResizeBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	RESIZE_PARAM* p = (RESIZE_PARAM*)pParam;
+	RESIZE_TABLE* TableY = p->TableY;
+	int nTaps = TableY->nTaps;
+	int nSlots = nTaps + 1;
+
+	// Nearest는 좌표 표만으로 복사
+	if (RESIZE_NEAREST == p->nMode) {
+		for (int y = nStartRow; y < nEndRow; y++) {
+			BYTE* pSrc = &p->Input[TableY->Index[y] * p->nWidth];
+			BYTE* pOut = &p->Output[y * p->nOutWidth];
+
+			for (int x = 0; x < p->nOutWidth; x++)
+				pOut[x] = pSrc[p->TableX->Index[x]];
+		}
+		return;
+	}
+
+	short* Cache = (short*)malloc(sizeof(short) * p->nOutWidth * nSlots);
+	int* CacheRow = (int*)malloc(sizeof(int) * nSlots);
+	short* Rows[64];
+
+	if (NULL == Cache || NULL == CacheRow) {
+		free(Cache);
+		free(CacheRow);
+		p->nError = 1;
+		return;
+	}
+
+	for (int i = 0; i < nSlots; i++)
+		CacheRow[i] = -1;
+
+	for (int y = nStartRow; y < nEndRow; y++) {
+		for (int k = 0; k < nTaps && k < 64; k++) {
+			int nRow = TableY->Index[y * nTaps + k];
+			int nSlot = nRow % nSlots;
+
+			// 출력 행이 증가하면 원본 행도 증가하므로 nTaps + 1 칸이면 충분
+			if (CacheRow[nSlot] != nRow) {
+				ResizeRowHorizontal(&p->Input[nRow * p->nWidth], &Cache[nSlot * p->nOutWidth], p->TableX, p->nOutWidth);
+				CacheRow[nSlot] = nRow;
+			}
+			Rows[k] = &Cache[nSlot * p->nOutWidth];
+		}
+
+		ResizeRowVertical(Rows, &TableY->Weight[y * nTaps], nTaps, &p->Output[y * p->nOutWidth], p->nOutWidth);
+	}
+
+	free(Cache);
+	free(CacheRow);
+
+	return;
+}
+
+/*
+ * @Function Name : ResizeImage
+ * @Descriotion : 영상을 nOutWidth x nOutHeight 크기로 Resize (이후 모든 함수의 입력으로 사용 가능)
+ * @Input : *Input, nWidth, nHeight, nOutWidth, nOutHeight, nMode(RESIZE_NEAREST, RESIZE_BILINEAR, RESIZE_AREA)
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int ResizeImage(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nOutWidth, int nOutHeight, int nMode)
+{
+	PROFILE_BEGIN();
+
+	RESIZE_TABLE TableX, TableY;
+	RESIZE_PARAM Param;
+
+	Param.nError = 1;
+
+	if (nOutWidth < 1 || nOutHeight < 1 || nMode < RESIZE_NEAREST || nMode > RESIZE_AREA)
+		goto CLEANUP;
+
+	// Area의 Tap 수 제한 (축소 배율 62배 이하)
+	if (RESIZE_AREA == nMode && (nWidth / nOutWidth > 62 || nHeight / nOutHeight > 62))
+		goto CLEANUP;
+
+	if (0 == BuildResizeTable(&TableX, nWidth, nOutWidth, nMode))
+		goto CLEANUP;
+	if (0 == BuildResizeTable(&TableY, nHeight, nOutHeight, nMode)) {
+		DestroyResizeTable(&TableX);
+		goto CLEANUP;
+	}
+
+	Param.Input = Input;
+	Param.Output = Output;
+	Param.nWidth = nWidth;
+	Param.nHeight = nHeight;
+	Param.nOutWidth = nOutWidth;
+	Param.nOutHeight = nOutHeight;
+	Param.nMode = nMode;
+	Param.TableX = &TableX;
+	Param.TableY = &TableY;
+	Param.nError = 0;
+
+	RunBands(ResizeBand, &Param, nOutHeight, GetBandCount(nOutHeight, 16));
+
+	DestroyResizeTable(&TableX);
+	DestroyResizeTable(&TableY);
+
+CLEANUP:
+	PROFILE_END(nOutWidth * nOutHeight, nWidth * nHeight, nOutWidth * nOutHeight);
+
+	return 0 == Param.nError;
+}
+
+/*
+ * ver 1.6 : 연산 결과 Cache
+ * (화소 데이터 + 연산 번호/인자/크기)의 64비트 Hash(XXH64)를 키로 출력 이미지를 파일(blob)로 저장
+ * 적중 시 필터 대신 Hash 1회 + blob 파일 Mapping으로 결과를 얻음, 전체 크기 상한을 넘으면 LRU 순으로 삭제
+ */
+
+// Cache 적중 실패 시 수행할 연산 (Daemon 절에 정의)
+int ApplyOperation(int nMode, int nParam, BYTE* Input, BYTE* Output, BYTE* Temp, int* pWidth, int* pHeight);
+
+#define CACHE_DIR				"../cache"
+#define CACHE_INDEX_NAME		"index.dat"
+#define CACHE_MAGIC				0x48434D49			// "IMCH"
+#define CACHE_MAX_BYTES			(256LL * 1024 * 1024)	// 기본 Cache 크기 상한
+#define CACHE_MAX_ENTRIES		4096
+
+#define XXH_PRIME1		11400714785074694791ULL
+#define XXH_PRIME2		14029467366897019727ULL
+#define XXH_PRIME3		1609587929392839161ULL
+#define XXH_PRIME4		9650029242287828579ULL
+#define XXH_PRIME5		2870177450012600261ULL
+
+// blob 파일 = CACHE_BLOB | 출력 화소
+typedef struct {
+	DWORD dwMagic;
+	int nMode, nParam;
+	int nWidth, nHeight;			// 입력 크기
+	int nOutWidth, nOutHeight;		// 출력 크기
+	int nReserved;
+	ULONGLONG ullKey;
+} CACHE_BLOB;
+
+typedef struct {
+	ULONGLONG ullKey;
+	ULONGLONG ullLastUse;			// LRU 시각 (클수록 최근)
+	long long llBytes;				// blob 파일 크기
+} CACHE_ENTRY;
+
+// 색인 파일 = CACHE_INDEX | nEntries x CACHE_ENTRY
+typedef struct {
+	DWORD dwMagic;
+	int nEntries;
+	ULONGLONG ullClock;
+	ULONGLONG ullHits, ullMisses, ullEvictions;
+} CACHE_INDEX;
+
+typedef struct {
+	int bOpen;
+	char Dir[256];
+	long long llMaxBytes, llBytes;
+	CACHE_INDEX Index;				// 누적 통계 (실행 사이에 유지)
+	CACHE_ENTRY Entry[CACHE_MAX_ENTRIES];
+} RESULT_CACHE;
+
+static RESULT_CACHE g_ResultCache;
+
+/*
+ * @Function Name : RotateLeft64
+ * @Descriotion : 64비트 왼쪽 회전
+ * @Input : ullValue, nBits
+ * @Output : 회전 결과
+ */
+ULONGLONG RotateLeft64(ULONGLONG ullValue, int nBits)
+{
+	return (ullValue << nBits) | (ullValue >> (64 - nBits));
+}
+
+/*
+ * @Function Name : Read64
+ * @Descriotion : 정렬되지 않은 주소에서 64비트 읽기 (Little Endian)
+ * @Input : *p
+ * @Output : 값
+ */
+ULONGLONG Read64(const BYTE* p)
+{
+	ULONGLONG ullValue;
+
+	memcpy(&ullValue, p, sizeof(ullValue));
+
+	return ullValue;
+}
+
+/*
+ * @Function Name : HashRound
+ * @Descriotion : XXH64 lane 1회 갱신
+ * @Input : ullAcc, ullInput
+ * @Output : 갱신된 lane
+ */
+ULONGLONG HashRound(ULONGLONG ullAcc, ULONGLONG ullInput)
+{
+	ullAcc += ullInput * XXH_PRIME2;
+	ullAcc = RotateLeft64(ullAcc, 31);
+
+	return ullAcc * XXH_PRIME1;
+}
+
+/*
+ * @Function Name : HashMerge
+ * @Descriotion : XXH64 lane을 최종 Hash에 합침
+ * @Input : ullHash, ullLane
+ * @Output : 합친 Hash
+ */
+ULONGLONG HashMerge(ULONGLONG ullHash, ULONGLONG ullLane)
+{
+	ullHash ^= HashRound(0, ullLane);
+
+	return ullHash * XXH_PRIME1 + XXH_PRIME4;
+}
+
+/*
+ * @Function Name : HashBytes
+ * @Descriotion : XXH64 Hash (32바이트 단위 4 lane 병렬, 메모리 대역폭에 가까운 속도)
+ * @Input : *Data, nLength, ullSeed
+ * @Output : 64비트 Hash
+ */
+ULONGLONG HashBytes(const BYTE* Data, size_t nLength, ULONGLONG ullSeed)
+{
+	const BYTE* p = Data;
+	const BYTE* pEnd = Data + nLength;
+	ULONGLONG ullHash;
+
+	if (nLength >= 32) {
+		ULONGLONG v1 = ullSeed + XXH_PRIME1 + XXH_PRIME2;
+		ULONGLONG v2 = ullSeed + XXH_PRIME2;
+		ULONGLONG v3 = ullSeed;
+		ULONGLONG v4 = ullSeed - XXH_PRIME1;
+
+		for (; p + 32 <= pEnd; p += 32) {
+			v1 = HashRound(v1, Read64(p));
+			v2 = HashRound(v2, Read64(p + 8));
+			v3 = HashRound(v3, Read64(p + 16));
+			v4 = HashRound(v4, Read64(p + 24));
+		}
+
+		ullHash = RotateLeft64(v1, 1) + RotateLeft64(v2, 7) + RotateLeft64(v3, 12) + RotateLeft64(v4, 18);
+		ullHash = HashMerge(ullHash, v1);
+		ullHash = HashMerge(ullHash, v2);
+		ullHash = HashMerge(ullHash, v3);
+		ullHash = HashMerge(ullHash, v4);
+	}
+	else
+		ullHash = ullSeed + XXH_PRIME5;
+
+	ullHash += (ULONGLONG)nLength;
+
+	// 나머지 (8, 4, 1바이트)
+	for (; p + 8 <= pEnd; p += 8) {
+		ullHash ^= HashRound(0, Read64(p));
+		ullHash = RotateLeft64(ullHash, 27) * XXH_PRIME1 + XXH_PRIME4;
+	}
+
+	if (p + 4 <= pEnd) {
+		DWORD dwValue;
+
+		memcpy(&dwValue, p, sizeof(dwValue));
+		ullHash ^= (ULONGLONG)dwValue * XXH_PRIME1;
+		ullHash = RotateLeft64(ullHash, 23) * XXH_PRIME2 + XXH_PRIME3;
+		p += 4;
+	}
+
+	for (; p < pEnd; p++) {
+		ullHash ^= (*p) * XXH_PRIME5;
+		ullHash = RotateLeft64(ullHash, 11) * XXH_PRIME1;
+	}
+
+	// Avalanche
+	ullHash ^= ullHash >> 33;
+	ullHash *= XXH_PRIME2;
+	ullHash ^= ullHash >> 29;
+	ullHash *= XXH_PRIME3;
+	ullHash ^= ullHash >> 32;
+
+	return ullHash;
+}
+
+/*
+ * @Function Name : GetCacheKey
+ * @Descriotion : 연산 번호/인자/크기의 Hash를 seed로 화소 데이터를 Hash하여 Cache 키 생성
+ * @Input : *Input, nWidth, nHeight, nMode, nParam
+ * @Output : Cache 키
+ */
+ULONGLONG GetCacheKey(BYTE* Input, int nWidth, int nHeight, int nMode, int nParam)
+{
+	int nOperation[4] = { nMode, nParam, nWidth, nHeight };
+
+	return HashBytes(Input, (size_t)nWidth * nHeight, HashBytes((BYTE*)nOperation, sizeof(nOperation), 0));
+}
+
+/*
+ * @Function Name : GetCacheBlobPath
+ * @Descriotion : Cache 키의 blob 파일 경로
+ * @Input : ullKey, nSize
+ * @Output : *Path
+ */
+void GetCacheBlobPath(char* Path, int nSize, ULONGLONG ullKey)
+{
+	sprintf_s(Path, nSize, "%s/%016llx.blob", g_ResultCache.Dir, ullKey);
+
+	return;
+}
+
+/*
+ * @Function Name : SaveCacheIndex
+ * @Descriotion : Cache 색인(항목, LRU 시각, 통계)을 파일로 저장
+ * @Input : g_ResultCache
+ * @Output : 성공 1, 실패 0
+ */
+int SaveCacheIndex(void)
+{
+	char Path[300];
+	FILE* fp = NULL;
+
+	sprintf_s(Path, sizeof(Path), "%s/%s", g_ResultCache.Dir, CACHE_INDEX_NAME);
+	fopen_s(&fp, Path, "wb");
+	if (NULL == fp)
+		return 0;
+
+	fwrite(&g_ResultCache.Index, sizeof(CACHE_INDEX), 1, fp);
+	fwrite(g_ResultCache.Entry, sizeof(CACHE_ENTRY), g_ResultCache.Index.nEntries, fp);
+	fclose(fp);
+
+	return 1;
+}
+
+/*
+ * @Function Name : OpenResultCache
+ * @Descriotion : Cache 폴더를 만들고 이전 실행의 색인을 읽음 (색인이 없거나 손상되면 빈 Cache)
+ * @Input : *Dir, llMaxBytes
+ * @Output : 성공 1, 실패 0
+ */
+int OpenResultCache(const char* Dir, long long llMaxBytes)
+{
+	char Path[300];
+	FILE* fp = NULL;
+
+	memset(&g_ResultCache, 0, sizeof(g_ResultCache));
+	strcpy_s(g_ResultCache.Dir, sizeof(g_ResultCache.Dir), Dir);
+	g_ResultCache.llMaxBytes = llMaxBytes;
+	g_ResultCache.Index.dwMagic = CACHE_MAGIC;
+
+	if (!CreateDirectoryA(Dir, NULL) && ERROR_ALREADY_EXISTS != GetLastError())
+		return 0;
+
+	sprintf_s(Path, sizeof(Path), "%s/%s", Dir, CACHE_INDEX_NAME);
+	fopen_s(&fp, Path, "rb");
+	if (NULL != fp) {
+		if (1 != fread(&g_ResultCache.Index, sizeof(CACHE_INDEX), 1, fp) || CACHE_MAGIC != g_ResultCache.Index.dwMagic ||
+			g_ResultCache.Index.nEntries < 0 || g_ResultCache.Index.nEntries > CACHE_MAX_ENTRIES ||
+			(size_t)g_ResultCache.Index.nEntries != fread(g_ResultCache.Entry, sizeof(CACHE_ENTRY), g_ResultCache.Index.nEntries, fp)) {
+			memset(&g_ResultCache.Index, 0, sizeof(CACHE_INDEX));
+			g_ResultCache.Index.dwMagic = CACHE_MAGIC;
+		}
+		fclose(fp);
+	}
+
+	for (int i = 0; i < g_ResultCache.Index.nEntries; i++)
+		g_ResultCache.llBytes += g_ResultCache.Entry[i].llBytes;
+
+	g_ResultCache.bOpen = 1;
+
+	return 1;
+}
+
+/*
+ * @Function Name : CloseResultCache
+ * @Descriotion : 색인 저장 후 Cache 닫기
+ * @Input :
+ * @Output :
+ */
+void CloseResultCache(void)
+{
+	if (g_ResultCache.bOpen)
+		SaveCacheIndex();
+
+	g_ResultCache.bOpen = 0;
+
+	return;
+}
+
+/*
+ * @Function Name : RemoveCacheEntry
+ * @Descriotion : 항목 i를 색인과 디스크에서 삭제 (마지막 항목을 빈 자리로 이동)
+ * @Input : nIndex
+ * @Output :
+ */
+void RemoveCacheEntry(int nIndex)
+{
+	char Path[300];
+
+	GetCacheBlobPath(Path, sizeof(Path), g_ResultCache.Entry[nIndex].ullKey);
+	remove(Path);
+
+	g_ResultCache.llBytes -= g_ResultCache.Entry[nIndex].llBytes;
+	g_ResultCache.Entry[nIndex] = g_ResultCache.Entry[--g_ResultCache.Index.nEntries];
+
+	return;
+}
+
+/*
+ * @Function Name : EvictCache
+ * @Descriotion : llIncoming 바이트를 추가해도 상한을 넘지 않도록 가장 오래 쓰이지 않은 항목부터 삭제
+ * @Input : llIncoming
+ * @Output :
+ */
+void EvictCache(long long llIncoming)
+{
+	while (g_ResultCache.Index.nEntries > 0 &&
+		(g_ResultCache.llBytes + llIncoming > g_ResultCache.llMaxBytes || CACHE_MAX_ENTRIES == g_ResultCache.Index.nEntries)) {
+		int nOldest = 0;
+
+		for (int i = 1; i < g_ResultCache.Index.nEntries; i++)
+			if (g_ResultCache.Entry[i].ullLastUse < g_ResultCache.Entry[nOldest].ullLastUse)
+				nOldest = i;
+
+		RemoveCacheEntry(nOldest);
+		g_ResultCache.Index.ullEvictions++;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : LookupCache
+ * @Descriotion : 키의 blob 파일을 Mapping하여 출력 이미지를 가져옴 (blob 머리의 연산/크기가 다르거나 파일이 잘렸으면 불일치로 처리)
+ * @Input : ullKey, nMode, nParam, nWidth, nHeight
+ * @Output : *Output, *pOutWidth, *pOutHeight, 적중 1, 실패 0
+ */
+int LookupCache(ULONGLONG ullKey, int nMode, int nParam, int nWidth, int nHeight, BYTE* Output, int* pOutWidth, int* pOutHeight)
+{
+	char Path[300];
+	HANDLE hFile, hMapping = NULL;
+	LARGE_INTEGER FileSize;
+	CACHE_BLOB* pBlob = NULL;
+	int nIndex = -1, nResult = 0;
+
+	for (int i = 0; i < g_ResultCache.Index.nEntries && nIndex < 0; i++)
+		if (ullKey == g_ResultCache.Entry[i].ullKey)
+			nIndex = i;
+
+	if (nIndex < 0)
+		return 0;
+
+	GetCacheBlobPath(Path, sizeof(Path), ullKey);
+	hFile = CreateFileA(Path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (INVALID_HANDLE_VALUE == hFile) {
+		// 외부에서 지워진 blob
+		RemoveCacheEntry(nIndex);
+		return 0;
+	}
+
+	// 머리보다 짧게 잘린 파일은 Mapping 전에 불일치로 처리
+	if (GetFileSizeEx(hFile, &FileSize) && FileSize.QuadPart >= (LONGLONG)sizeof(CACHE_BLOB)) {
+		hMapping = CreateFileMappingA(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+		pBlob = NULL != hMapping ? (CACHE_BLOB*)MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+	}
+
+	// 출력 화소도 실제 파일 크기 안에 있어야 복사 (색인의 크기만으로는 잘린 파일을 알 수 없음)
+	if (NULL != pBlob && CACHE_MAGIC == pBlob->dwMagic && ullKey == pBlob->ullKey && nMode == pBlob->nMode && nParam == pBlob->nParam &&
+		nWidth == pBlob->nWidth && nHeight == pBlob->nHeight && pBlob->nOutWidth > 0 && pBlob->nOutHeight > 0 &&
+		(long long)sizeof(CACHE_BLOB) + (long long)pBlob->nOutWidth * pBlob->nOutHeight == g_ResultCache.Entry[nIndex].llBytes &&
+		(long long)sizeof(CACHE_BLOB) + (long long)pBlob->nOutWidth * pBlob->nOutHeight <= FileSize.QuadPart) {
+		memcpy(Output, (BYTE*)(pBlob + 1), pBlob->nOutWidth * pBlob->nOutHeight);
+		*pOutWidth = pBlob->nOutWidth;
+		*pOutHeight = pBlob->nOutHeight;
+		g_ResultCache.Entry[nIndex].ullLastUse = ++g_ResultCache.Index.ullClock;
+		nResult = 1;
+	}
+
+	if (NULL != pBlob)
+		UnmapViewOfFile(pBlob);
+	if (NULL != hMapping)
+		CloseHandle(hMapping);
+	CloseHandle(hFile);
+
+	if (0 == nResult)
+		RemoveCacheEntry(nIndex);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : StoreCache
+ * @Descriotion : 출력 이미지를 blob 파일로 저장하고 색인에 추가 (필요하면 LRU 삭제)
+ * @Input : ullKey, nMode, nParam, nWidth, nHeight, *Output, nOutWidth, nOutHeight
+ * @Output : 성공 1, 실패 0
+ */
+int StoreCache(ULONGLONG ullKey, int nMode, int nParam, int nWidth, int nHeight, BYTE* Output, int nOutWidth, int nOutHeight)
+{
+	CACHE_BLOB Blob = { CACHE_MAGIC, nMode, nParam, nWidth, nHeight, nOutWidth, nOutHeight, 0, ullKey };
+	long long llBytes = (long long)sizeof(CACHE_BLOB) + (long long)nOutWidth * nOutHeight;
+	char Path[300];
+	FILE* fp = NULL;
+	CACHE_ENTRY* pEntry;
+
+	if (llBytes > g_ResultCache.llMaxBytes)
+		return 0;
+
+	EvictCache(llBytes);
+
+	GetCacheBlobPath(Path, sizeof(Path), ullKey);
+	fopen_s(&fp, Path, "wb");
+	if (NULL == fp)
+		return 0;
+
+	if (1 != fwrite(&Blob, sizeof(CACHE_BLOB), 1, fp) || (size_t)nOutWidth * nOutHeight != fwrite(Output, 1, (size_t)nOutWidth * nOutHeight, fp)) {
+		fclose(fp);
+		remove(Path);
+		return 0;
+	}
+	fclose(fp);
+
+	pEntry = &g_ResultCache.Entry[g_ResultCache.Index.nEntries++];
+	pEntry->ullKey = ullKey;
+	pEntry->ullLastUse = ++g_ResultCache.Index.ullClock;
+	pEntry->llBytes = llBytes;
+	g_ResultCache.llBytes += llBytes;
+
+	// 비정상 종료에도 디스크의 blob과 색인이 맞도록 추가할 때마다 저장
+	SaveCacheIndex();
+
+	return 1;
+}
+
+/*
+ * @Function Name : CachedOperation
+ * @Descriotion : Cache를 거쳐 ApplyOperation 수행 (Cache가 닫혀 있으면 바로 수행)
+ * @Input : nMode, nParam, *Input, *Temp, *pWidth, *pHeight
+ * @Output : *Output, *pWidth, *pHeight, 성공 1, 실패 0
+ */
+int CachedOperation(int nMode, int nParam, BYTE* Input, BYTE* Output, BYTE* Temp, int* pWidth, int* pHeight)
+{
+	int nWidth = *pWidth, nHeight = *pHeight;
+	ULONGLONG ullKey;
+
+	if (!g_ResultCache.bOpen)
+		return ApplyOperation(nMode, nParam, Input, Output, Temp, pWidth, pHeight);
+
+	ullKey = GetCacheKey(Input, nWidth, nHeight, nMode, nParam);
+
+	if (LookupCache(ullKey, nMode, nParam, nWidth, nHeight, Output, pWidth, pHeight)) {
+		g_ResultCache.Index.ullHits++;
+		return 1;
+	}
+
+	g_ResultCache.Index.ullMisses++;
+
+	if (0 == ApplyOperation(nMode, nParam, Input, Output, Temp, pWidth, pHeight))
+		return 0;
+
+	StoreCache(ullKey, nMode, nParam, nWidth, nHeight, Output, *pWidth, *pHeight);
+
+	return 1;
+}
+
+/*
+ * @Function Name : PrintCacheStats
+ * @Descriotion : Cache 적중/실패/삭제 횟수와 사용 크기 출력
+ * @Input : g_ResultCache
+ * @Output :
+ */
+void PrintCacheStats(void)
+{
+	ULONGLONG ullTotal = g_ResultCache.Index.ullHits + g_ResultCache.Index.ullMisses;
+
+	printf("Cache : hits = %llu, misses = %llu, hit ratio = %.1f%%, evictions = %llu\n", g_ResultCache.Index.ullHits, g_ResultCache.Index.ullMisses,
+		ullTotal > 0 ? 100.0 * g_ResultCache.Index.ullHits / ullTotal : 0.0, g_ResultCache.Index.ullEvictions);
+	printf("Cache : entries = %d, bytes = %lld / %lld\n", g_ResultCache.Index.nEntries, g_ResultCache.llBytes, g_ResultCache.llMaxBytes);
+
+	return;
+}
+
+/*
+ * ver 1.5 : Daemon 모드
+ * 프로세스를 상주시키고 Named Pipe로 요청(연산 또는 연산 Pipeline)을 받아, 공유 메모리(File Mapping) 슬롯의
+ * 프레임을 복사 없이 제자리에서 처리 (슬롯마다 A / B 두 영역을 번갈아 입력/출력으로 사용)
+ * 작업 스레드, 작업 버퍼, Convolution 교차점 측정값은 요청 사이에 유지
+ */
+
+#define DAEMON_PIPE_NAME		"\\\\.\\pipe\\imgprocessing"
+#define DAEMON_SHM_NAME			"Local\\imgprocessing_frames"
+#define DAEMON_MAGIC			0x50474D49		// "IMGP"
+#define DAEMON_SLOTS			4					// 공유 메모리 슬롯 수
+#define DAEMON_SLOT_SIZE		(16 * 1024 * 1024)	// 슬롯 영역 하나의 크기 (최대 프레임 바이트)
+#define DAEMON_MAX_PIPELINE		8					// 요청당 최대 연산 수
+
+#define SLOT_FREE				0
+#define SLOT_BUSY				1
+
+// 공유 메모리 = SHM_HEADER | DAEMON_SLOTS x (SHM_SLOT | 영역 A | 영역 B)
+typedef struct {
+	DWORD dwMagic;
+	int nSlots;
+	int nSlotSize;
+	int nReserved[13];		// 64바이트 정렬
+} SHM_HEADER;
+
+typedef struct {
+	volatile LONG lState;	// SLOT_FREE / SLOT_BUSY (클라이언트가 Interlocked로 점유)
+	int nReserved[15];		// 64바이트 정렬
+} SHM_SLOT;
+
+// 클라이언트 -> Daemon
+typedef struct {
+	int nSlot;								// 프레임이 들어 있는 슬롯 (영역 A)
+	int nWidth, nHeight;
+	int nOps;								// 연산 수 (0이면 연결 확인)
+	int nMode[DAEMON_MAX_PIPELINE];			// 메뉴 번호와 같은 연산 번호
+	int nParam[DAEMON_MAX_PIPELINE];		// 연산 인자 (밝기, 임계값, 대비 x 100, Kernel 크기, 크기 x 10 + Pooling 종류)
+} DAEMON_REQUEST;
+
+// Daemon -> 클라이언트
+typedef struct {
+	int nResult;			// 성공 1, 실패 0
+	int nOutWidth, nOutHeight;
+	int nResultArea;		// 결과가 있는 영역 (0 : A, 1 : B)
+} DAEMON_RESPONSE;
+
+// Daemon 상태 (요청 처리는 g_DaemonLock으로 한 번에 하나씩, 각 요청은 RunBands로 전체 코어 사용)
+static CRITICAL_SECTION g_DaemonLock;
+static BYTE* g_DaemonShm = NULL;
+static BYTE* g_DaemonTemp = NULL;
+
+/*
+ * @Function Name : GetSlotArea
+ * @Descriotion : 공유 메모리에서 슬롯의 영역(0 : A, 1 : B) 주소
+ * @Input : *Shm, nSlot, nArea
+ * @Output : 영역 주소
+ */
+BYTE* GetSlotArea(BYTE* Shm, int nSlot, int nArea)
+{
+	size_t nSlotBytes = sizeof(SHM_SLOT) + 2 * (size_t)DAEMON_SLOT_SIZE;
+
+	return Shm + sizeof(SHM_HEADER) + nSlotBytes * nSlot + sizeof(SHM_SLOT) + (size_t)DAEMON_SLOT_SIZE * nArea;
+}
+
+/*
+ * @Function Name : GetSlot
+ * @Descriotion : 공유 메모리에서 슬롯 헤더 주소
+ * @Input : *Shm, nSlot
+ * @Output : 슬롯 헤더
+ */
+SHM_SLOT* GetSlot(BYTE* Shm, int nSlot)
+{
+	size_t nSlotBytes = sizeof(SHM_SLOT) + 2 * (size_t)DAEMON_SLOT_SIZE;
+
+	return (SHM_SLOT*)(Shm + sizeof(SHM_HEADER) + nSlotBytes * nSlot);
+}
+
+/*
+ * @Function Name : ApplyOperation
+ * @Descriotion : 메뉴 번호의 연산 하나를 Input -> Output 으로 수행 (Daemon Pipeline, 결과 Cache용, 파일 입출력 없음)
+ *                지원 : 1 ~ 3, 5 ~ 19, 20(nParam = Kernel 크기), 21, 25(nParam = 크기 x 10 + 종류), 27
+ * @Input : nMode, nParam, *Input, *Temp, *pWidth, *pHeight
+ * @Output : *Output, *pWidth, *pHeight (크기가 바뀌는 연산), 성공 1, 실패 0
+ */
+int ApplyOperation(int nMode, int nParam, BYTE* Input, BYTE* Output, BYTE* Temp, int* pWidth, int* pHeight)
+{
+	int nWidth = *pWidth, nHeight = *pHeight;
+	int nImgSize = nWidth * nHeight;
+	IMAGE_STATS Stats;				// 호출마다 다른 버퍼가 들어오므로 보관하지 않고 띠 병렬 한 패스로 계산
+	BYTE bLow, bHigh;
+	double* Kernel;
+	IMAGE_PYRAMID Pyramid;
+
+	Stats.Image = NULL;
+
+	// 경계를 쓰지 않는 Convolution 결과가 이전 프레임과 섞이지 않도록 초기화
+	memset(Output, 0, nImgSize);
+
+	switch (nMode) {
+	case 1:  InverseImage(Input, Output, nWidth, nHeight); break;
+	case 2:  AdjustBrightness(Input, Output, nWidth, nHeight, nParam); break;
+	case 3:  AdjustContrast(Input, Output, nWidth, nHeight, nParam / 100.0); break;
+	case 5:
+		GetImageStats(&Stats, Input, nWidth, nHeight);
+		GenerateBinarization(Input, Output, nWidth, nHeight, GonzalezMethodRange(Stats.nHisto, Stats.bMin, Stats.bMax));
+		break;
+	case 6:  GenerateBinarization(Input, Output, nWidth, nHeight, (BYTE)nParam); break;
+	case 7:
+		GetImageStats(&Stats, Input, nWidth, nHeight);
+		HistogramStretchingRange(Input, Output, Stats.bMin, Stats.bMax, nWidth, nHeight);
+		break;
+	case 8:
+		GetImageStats(&Stats, Input, nWidth, nHeight);
+		HistogramEqualization(Input, Output, Stats.nHisto, nWidth, nHeight);
+		break;
+	case 9:  AverageConvolution(Input, Output, nWidth, nHeight); break;
+	case 10: GaussianConvolution(Input, Output, nWidth, nHeight); break;
+	case 11: LaplacianConvolution(Input, Output, nWidth, nHeight); break;
+	case 12: X_PrewittConvolution(Input, Output, nWidth, nHeight); break;
+	case 13: Y_PrewittConvolution(Input, Output, nWidth, nHeight); break;
+	case 15: X_SobelConvolution(Input, Output, nWidth, nHeight); break;
+	case 16: Y_SobelConvolution(Input, Output, nWidth, nHeight); break;
+	case 14:
+	case 17:
+		memset(Temp, 0, nImgSize);
+		if (14 == nMode) {
+			X_PrewittConvolution(Input, Temp, nWidth, nHeight);
+			Y_PrewittConvolution(Input, Output, nWidth, nHeight);
+		}
+		else {
+			X_SobelConvolution(Input, Temp, nWidth, nHeight);
+			Y_SobelConvolution(Input, Output, nWidth, nHeight);
+		}
+		for (int i = 0; i < nImgSize; i++)
+			if (Temp[i] > Output[i])
+				Output[i] = Temp[i];
+		break;
+	case 18: HPF_LaplacianConvolution(Input, Output, nWidth, nHeight); break;
+	case 19: MedianFilter(Input, Output, nWidth, nHeight); break;
+	case 20:
+		if (nParam < 3 || 0 == nParam % 2 || nParam > nWidth || nParam > nHeight)
+			return 0;
+		Kernel = (double*)malloc(sizeof(double) * nParam * nParam);
+		if (NULL == Kernel)
+			return 0;
+		GenerateGaussianKernel(Kernel, nParam);
+		KernelConvolution(Input, Output, nWidth, nHeight, Kernel, nParam);
+		free(Kernel);
+		break;
+	case 21:
+		if (0 == CannyEdgeDetection(Input, Output, nWidth, nHeight, &bLow, &bHigh))
+			return 0;
+		break;
+	case 25:
+		// nParam = 크기 x 10 + 종류 (요청으로 들어온 값이므로 크기/종류를 먼저 검사)
+		if ((2 != nParam / 10 && 3 != nParam / 10) || nParam % 10 < POOL_MIN || nParam % 10 > POOL_MEDIAN)
+			return 0;
+		if (0 == StridedPooling(Input, Output, nWidth, nHeight, nParam / 10, nParam % 10))
+			return 0;
+		*pWidth = nWidth / (nParam / 10);
+		*pHeight = nHeight / (nParam / 10);
+		break;
+	case 27:
+		if (0 == BuildGaussianPyramid(Input, nWidth, nHeight, 2, &Pyramid))
+			return 0;
+		if (Pyramid.nLevels < 2 || 0 == PyramidExpand(Pyramid.Level[1], Output, Pyramid.nWidth[1], Pyramid.nHeight[1], nWidth, nHeight)) {
+			DestroyGaussianPyramid(&Pyramid);
+			return 0;
+		}
+		DestroyGaussianPyramid(&Pyramid);
+		break;
+	default:
+		return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * @Function Name : HandleDaemonRequest
+ * @Descriotion : 슬롯의 영역 A에 있는 프레임에 요청된 연산들을 순서대로 적용 (영역 A, B를 번갈아 사용하여 복사 없음)
+ * @Input : *Shm, *Request
+ * @Output : *Response
+ */
+void HandleDaemonRequest(BYTE* Shm, DAEMON_REQUEST* Request, DAEMON_RESPONSE* Response)
+{
+	int nWidth = Request->nWidth, nHeight = Request->nHeight;
+	int nArea = 0;
+
+	memset(Response, 0, sizeof(DAEMON_RESPONSE));
+
+	if (Request->nSlot < 0 || Request->nSlot >= DAEMON_SLOTS || Request->nOps < 0 || Request->nOps > DAEMON_MAX_PIPELINE ||
+		nWidth < 1 || nHeight < 1 || (long long)nWidth * nHeight > DAEMON_SLOT_SIZE)
+		return;
+
+	for (int i = 0; i < Request->nOps; i++) {
+		BYTE* Input = GetSlotArea(Shm, Request->nSlot, nArea);
+		BYTE* Output = GetSlotArea(Shm, Request->nSlot, 1 - nArea);
+
+		if (0 == CachedOperation(Request->nMode[i], Request->nParam[i], Input, Output, g_DaemonTemp, &nWidth, &nHeight))
+			return;
+
+		nArea = 1 - nArea;
+	}
+
+	Response->nResult = 1;
+	Response->nOutWidth = nWidth;
+	Response->nOutHeight = nHeight;
+	Response->nResultArea = nArea;
+
+	return;
+}
+
+/*
+ * @Function Name : DaemonClientThread
+ * @Descriotion : 연결된 클라이언트 하나의 요청을 연결이 끊길 때까지 처리
+ * @Input : lpParam (Pipe 핸들)
+ * @Output : 0
+ */
+DWORD WINAPI DaemonClientThread(LPVOID lpParam)
+{
+	HANDLE hPipe = (HANDLE)lpParam;
+	DAEMON_REQUEST Request;
+	DAEMON_RESPONSE Response;
+	DWORD dwBytes = 0;
+
+	while (ReadFile(hPipe, &Request, sizeof(Request), &dwBytes, NULL) && sizeof(Request) == dwBytes) {
+		EnterCriticalSection(&g_DaemonLock);
+		HandleDaemonRequest(g_DaemonShm, &Request, &Response);
+		if (g_ResultCache.bOpen) {
+			DiagRecord("Cache hits", (int)g_ResultCache.Index.ullHits);
+			DiagRecord("Cache misses", (int)g_ResultCache.Index.ullMisses);
+		}
+
+		// 연산 중 기록된 진단 값은 처리 후 출력 (진단 버퍼는 다른 요청 스레드와 공유하므로 Lock 안에서)
+		FlushDiag();
+		LeaveCriticalSection(&g_DaemonLock);
+
+		if (!WriteFile(hPipe, &Response, sizeof(Response), &dwBytes, NULL))
+			break;
+	}
+
+	DisconnectNamedPipe(hPipe);
+	CloseHandle(hPipe);
+
+	return 0;
+}
+
+/*
+ * @Function Name : RunDaemon
+ * @Descriotion : 공유 메모리를 만들고 작업 스레드/측정값을 미리 준비한 뒤 Named Pipe 연결을 계속 받음
+ * @Input :
+ * @Output : 실패 시 0 (정상 동작 중에는 반환하지 않음)
+ */
+int RunDaemon(void)
+{
+	size_t nShmSize = sizeof(SHM_HEADER) + (sizeof(SHM_SLOT) + 2 * (size_t)DAEMON_SLOT_SIZE) * DAEMON_SLOTS;
+	HANDLE hMapping, hPipe, hThread;
+	SHM_HEADER* pHeader;
+
+	hMapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+		(DWORD)((unsigned long long)nShmSize >> 32), (DWORD)(nShmSize & 0xFFFFFFFF), DAEMON_SHM_NAME);
+	if (NULL == hMapping) {
+		printf("Error : shared memory error = %lu\n", GetLastError());
+		return 0;
+	}
+
+	g_DaemonShm = (BYTE*)MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, nShmSize);
+	g_DaemonTemp = (BYTE*)malloc(DAEMON_SLOT_SIZE);
+
+	if (NULL == g_DaemonShm || NULL == g_DaemonTemp) {
+		printf("Error : memory allocation error\n");
+		if (NULL != g_DaemonShm)
+			UnmapViewOfFile(g_DaemonShm);
+		free(g_DaemonTemp);
+		CloseHandle(hMapping);
+		return 0;
+	}
+
+	pHeader = (SHM_HEADER*)g_DaemonShm;
+	pHeader->nSlots = DAEMON_SLOTS;
+	pHeader->nSlotSize = DAEMON_SLOT_SIZE;
+	for (int i = 0; i < DAEMON_SLOTS; i++)
+		GetSlot(g_DaemonShm, i)->lState = SLOT_FREE;
+	pHeader->dwMagic = DAEMON_MAGIC;
+
+	// 요청 사이에 유지할 작업 스레드와 측정값 준비
+	InitializeCriticalSection(&g_DaemonLock);
+	StartBandWorkers();
+	CalibrateConvolution();
+
+	if (0 == OpenResultCache(CACHE_DIR, CACHE_MAX_BYTES))
+		printf("Warning : result cache disabled (%s)\n", CACHE_DIR);
+
+	printf("Daemon : %s, %s (%d slots x %d bytes)\n", DAEMON_PIPE_NAME, DAEMON_SHM_NAME, DAEMON_SLOTS, DAEMON_SLOT_SIZE);
+
+	while (1) {
+		hPipe = CreateNamedPipeA(DAEMON_PIPE_NAME, PIPE_ACCESS_DUPLEX, PIPE_TYPE_MESSAGE | PIPE_READMODE_MESSAGE | PIPE_WAIT,
+			PIPE_UNLIMITED_INSTANCES, sizeof(DAEMON_RESPONSE), sizeof(DAEMON_REQUEST), 0, NULL);
+
+		if (INVALID_HANDLE_VALUE == hPipe) {
+			printf("Error : pipe create error = %lu\n", GetLastError());
+			break;
+		}
+
+		if (!ConnectNamedPipe(hPipe, NULL) && ERROR_PIPE_CONNECTED != GetLastError()) {
+			CloseHandle(hPipe);
+			continue;
+		}
+
+		hThread = CreateThread(NULL, 0, DaemonClientThread, hPipe, 0, NULL);
+		if (NULL == hThread) {
+			DisconnectNamedPipe(hPipe);
+			CloseHandle(hPipe);
+			continue;
+		}
+		CloseHandle(hThread);
+	}
+
+	CloseResultCache();
+	StopBandWorkers();
+	DeleteCriticalSection(&g_DaemonLock);
+	UnmapViewOfFile(g_DaemonShm);
+	CloseHandle(hMapping);
+	free(g_DaemonTemp);
+
+	return 0;
+}
+
+/*
+ * @Function Name : DaemonClientRequest
+ * @Descriotion : Daemon의 빈 슬롯을 점유하여 프레임을 넣고 요청을 보낸 뒤, 결과 영역에서 출력을 가져옴
+ * @Input : *Input, nWidth, nHeight, *Request(nMode, nParam, nOps)
+ * @Output : *Output, *pOutWidth, *pOutHeight, 성공 1, 실패 0
+ */
+int DaemonClientRequest(BYTE* Input, BYTE* Output, int nWidth, int nHeight, DAEMON_REQUEST* Request, int* pOutWidth, int* pOutHeight)
+{
+	size_t nShmSize = sizeof(SHM_HEADER) + (sizeof(SHM_SLOT) + 2 * (size_t)DAEMON_SLOT_SIZE) * DAEMON_SLOTS;
+	DAEMON_RESPONSE Response;
+	DWORD dwMode = PIPE_READMODE_MESSAGE, dwBytes = 0;
+	HANDLE hMapping, hPipe;
+	BYTE* Shm;
+	int nSlot = -1, nResult = 0;
+
+	if ((long long)nWidth * nHeight > DAEMON_SLOT_SIZE)
+		return 0;
+
+	hMapping = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, DAEMON_SHM_NAME);
+	if (NULL == hMapping)
+		return 0;
+
+	Shm = (BYTE*)MapViewOfFile(hMapping, FILE_MAP_ALL_ACCESS, 0, 0, nShmSize);
+	if (NULL == Shm || DAEMON_MAGIC != ((SHM_HEADER*)Shm)->dwMagic) {
+		if (NULL != Shm)
+			UnmapViewOfFile(Shm);
+		CloseHandle(hMapping);
+		return 0;
+	}
+
+	// 빈 슬롯 점유
+	for (int i = 0; i < DAEMON_SLOTS && nSlot < 0; i++)
+		if (SLOT_FREE == InterlockedCompareExchange(&GetSlot(Shm, i)->lState, SLOT_BUSY, SLOT_FREE))
+			nSlot = i;
+
+	hPipe = CreateFileA(DAEMON_PIPE_NAME, GENERIC_READ | GENERIC_WRITE, 0, NULL, OPEN_EXISTING, 0, NULL);
+
+	if (nSlot >= 0 && INVALID_HANDLE_VALUE != hPipe && SetNamedPipeHandleState(hPipe, &dwMode, NULL, NULL)) {
+		memcpy(GetSlotArea(Shm, nSlot, 0), Input, nWidth * nHeight);
+
+		Request->nSlot = nSlot;
+		Request->nWidth = nWidth;
+		Request->nHeight = nHeight;
+
+		if (WriteFile(hPipe, Request, sizeof(DAEMON_REQUEST), &dwBytes, NULL) &&
+			ReadFile(hPipe, &Response, sizeof(Response), &dwBytes, NULL) && sizeof(Response) == dwBytes && Response.nResult) {
+			memcpy(Output, GetSlotArea(Shm, nSlot, Response.nResultArea), Response.nOutWidth * Response.nOutHeight);
+			*pOutWidth = Response.nOutWidth;
+			*pOutHeight = Response.nOutHeight;
+			nResult = 1;
+		}
+	}
+
+	if (INVALID_HANDLE_VALUE != hPipe)
+		CloseHandle(hPipe);
+	if (nSlot >= 0)
+		InterlockedExchange(&GetSlot(Shm, nSlot)->lState, SLOT_FREE);
+	UnmapViewOfFile(Shm);
+	CloseHandle(hMapping);
+
+	return nResult;
+}
+
+/*
+ * ver 1.7 : ROI(관심 영역) 처리
+ * 사각형 목록 + 선택적 Mask 영역만 처리 (이웃 연산은 연산 반경만큼 halo를 붙여 잘라낸 뒤 처리하고 안쪽만 되돌려 씀)
+ * 히스토그램 기반 연산(5, 7, 8)은 ROI 화소만으로 히스토그램을 만들어 변환표(LUT)로 적용
+ * 파일에서 읽을 때는 ROI + halo가 걸친 행만 읽음
+ */
+
+#define MAX_ROI_RECTS		64
+
+typedef struct {
+	int nLeft, nTop;		// 버퍼 좌표 (BMP 행 순서 그대로, 0행 = 파일의 첫 행)
+	int nWidth, nHeight;
+} ROI_RECT;
+
+typedef struct {
+	int nRects;
+	ROI_RECT Rect[MAX_ROI_RECTS];
+	BYTE* Mask;				// 이미지와 같은 크기, 0이 아닌 화소만 처리 (NULL이면 사각형 전체)
+} ROI;
+
+/*
+ * @Function Name : GetRoiHalo
+ * @Descriotion : 연산이 출력 화소 하나를 만들 때 읽는 이웃 반경 (ROI에서 지원하지 않는 연산은 -1)
+ * @Input : nMode, nParam
+ * @Output : halo 크기
+ */
+int GetRoiHalo(int nMode, int nParam)
+{
+	switch (nMode) {
+	case 1: case 2: case 3: case 5: case 6: case 7: case 8:
+		return 0;
+	case 9: case 10: case 11: case 12: case 13: case 14:
+	case 15: case 16: case 17: case 18: case 19:
+		return 1;
+	case 20:
+		return nParam / 2;
+	default:
+		// 크기가 바뀌는 연산(25, 27)과 Canny(21)는 ROI에 적용하지 않음
+		// Canny는 임계값을 영상 전체 기울기 히스토그램으로 정하고 이력 추적이 halo 밖까지 이어지므로 잘라낸 영역으로는 같은 결과가 나오지 않음
+		return -1;
+	}
+}
+
+/*
+ * @Function Name : ClipRoi
+ * @Descriotion : 사각형을 이미지 안으로 자르고 빈 사각형 제거
+ * @Input : *Roi, nWidth, nHeight
+ * @Output : *Roi, 남은 사각형 수
+ */
+int ClipRoi(ROI* Roi, int nWidth, int nHeight)
+{
+	int nCount = 0;
+
+	for (int i = 0; i < Roi->nRects; i++) {
+		ROI_RECT* r = &Roi->Rect[i];
+		int nLeft = r->nLeft < 0 ? 0 : r->nLeft;
+		int nTop = r->nTop < 0 ? 0 : r->nTop;
+		int nRight = r->nLeft + r->nWidth > nWidth ? nWidth : r->nLeft + r->nWidth;
+		int nBottom = r->nTop + r->nHeight > nHeight ? nHeight : r->nTop + r->nHeight;
+
+		if (nRight <= nLeft || nBottom <= nTop)
+			continue;
+
+		Roi->Rect[nCount].nLeft = nLeft;
+		Roi->Rect[nCount].nTop = nTop;
+		Roi->Rect[nCount].nWidth = nRight - nLeft;
+		Roi->Rect[nCount].nHeight = nBottom - nTop;
+		nCount++;
+	}
+
+	Roi->nRects = nCount;
+
+	return nCount;
+}
+
+/*
+ * @Function Name : MarkRoiRows
+ * @Descriotion : ROI 사각형 + halo가 걸친 행 표시
+ * @Input : *Roi, nHeight, nHalo
+ * @Output : *RowNeeded (행마다 1/0), 표시된 행 수
+ */
+int MarkRoiRows(ROI* Roi, int nHeight, int nHalo, BYTE* RowNeeded)
+{
+	int nCount = 0;
+
+	memset(RowNeeded, 0, nHeight);
+
+	for (int i = 0; i < Roi->nRects; i++) {
+		int nTop = Roi->Rect[i].nTop - nHalo < 0 ? 0 : Roi->Rect[i].nTop - nHalo;
+		int nBottom = Roi->Rect[i].nTop + Roi->Rect[i].nHeight + nHalo > nHeight ? nHeight : Roi->Rect[i].nTop + Roi->Rect[i].nHeight + nHalo;
+
+		for (int y = nTop; y < nBottom; y++)
+			RowNeeded[y] = 1;
+	}
+
+	for (int y = 0; y < nHeight; y++)
+		nCount += RowNeeded[y];
+
+	return nCount;
+}
+
+/*
+ * @Function Name : ReadRoiRows
+ * @Descriotion : 파일의 lOffset부터 저장된 화소 중 표시된 행만 읽음 (연속된 행은 한 번에 읽음, 나머지 행은 그대로 둠)
+ * @Input : *fp, lOffset, nWidth, nHeight, *RowNeeded
+ * @Output : *Buffer, 읽은 바이트 수 (실패 시 -1)
+ */
+long long ReadRoiRows(FILE* fp, long lOffset, BYTE* Buffer, int nWidth, int nHeight, BYTE* RowNeeded)
+{
+	long long llRead = 0;
+
+	for (int y = 0; y < nHeight; ) {
+		int nEnd = y;
+
+		if (!RowNeeded[y]) {
+			y++;
+			continue;
+		}
+
+		while (nEnd < nHeight && RowNeeded[nEnd])
+			nEnd++;
+
+		if (0 != fseek(fp, lOffset + (long)y * nWidth, SEEK_SET) ||
+			(size_t)(nEnd - y) * nWidth != fread(&Buffer[y * nWidth], 1, (size_t)(nEnd - y) * nWidth, fp))
+			return -1;
+
+		llRead += (long long)(nEnd - y) * nWidth;
+		y = nEnd;
+	}
+
+	return llRead;
+}
+
+/*
+ * @Function Name : InsideEarlierRect
+ * @Descriotion : (x, y)가 nIndex 이전 사각형에 포함되는지 확인 (겹친 화소를 한 번만 세기 위함)
+ * @Input : *Roi, nIndex, x, y
+ * @Output : 포함 1, 아니면 0
+ */
+int InsideEarlierRect(ROI* Roi, int nIndex, int x, int y)
+{
+	for (int i = 0; i < nIndex; i++) {
+		ROI_RECT* r = &Roi->Rect[i];
+
+		if (x >= r->nLeft && x < r->nLeft + r->nWidth && y >= r->nTop && y < r->nTop + r->nHeight)
+			return 1;
+	}
+
+	return 0;
+}
+
+/*
+ * @Function Name : GenerateRoiHistogram
+ * @Descriotion : ROI(사각형 합집합 ∩ Mask) 화소만으로 히스토그램 생성
+ * @Input : *Input, nWidth, *Roi
+ * @Output : *Histogram, ROI 화소 수
+ */
+int GenerateRoiHistogram(BYTE* Input, int nWidth, ROI* Roi, int* Histogram)
+{
+	int nCount = 0;
+
+	memset(Histogram, 0, sizeof(int) * 256);
+
+	for (int i = 0; i < Roi->nRects; i++) {
+		ROI_RECT* r = &Roi->Rect[i];
+		int bOverlap = 0;
+
+		// 앞의 사각형과 겹치지 않으면 화소별 확인 생략
+		for (int j = 0; j < i && !bOverlap; j++)
+			bOverlap = r->nLeft < Roi->Rect[j].nLeft + Roi->Rect[j].nWidth && Roi->Rect[j].nLeft < r->nLeft + r->nWidth &&
+				r->nTop < Roi->Rect[j].nTop + Roi->Rect[j].nHeight && Roi->Rect[j].nTop < r->nTop + r->nHeight;
+
+		for (int y = r->nTop; y < r->nTop + r->nHeight; y++) {
+			for (int x = r->nLeft; x < r->nLeft + r->nWidth; x++) {
+				if (NULL != Roi->Mask && 0 == Roi->Mask[y * nWidth + x])
+					continue;
+				if (bOverlap && InsideEarlierRect(Roi, i, x, y))
+					continue;
+
+				Histogram[Input[y * nWidth + x]]++;
+				nCount++;
+			}
+		}
+	}
+
+	return nCount;
+}
+
+/*
+ * @Function Name : BuildRoiLut
+ * @Descriotion : ROI 히스토그램으로 히스토그램 기반 연산(5, 7, 8)의 밝기 변환표 생성 (전체 이미지 함수와 같은 식)
+ * @Input : nMode, *Histogram, nCount
+ * @Output : *Lut
+ */
+void BuildRoiLut(int nMode, int* Histogram, int nCount, BYTE* Lut)
+{
+	BYTE Ramp[256];
+	int nSum = 0;
+
+	for (int i = 0; i < 256; i++)
+		Ramp[i] = (BYTE)i;
+
+	if (5 == nMode)
+		GenerateBinarization(Ramp, Lut, 256, 1, GonzalezMethod(Histogram));
+	else if (7 == nMode)
+		HistogramStretching(Ramp, Lut, Histogram, 256, 1);
+	else {
+		// HistogramEqualization과 같은 식, 총 화소 수만 ROI 화소 수
+		for (int i = 0; i < 256; i++) {
+			nSum += Histogram[i];
+			Lut[i] = (BYTE)(255 / (double)nCount * nSum);
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : ProcessRoi
+ * @Descriotion : ROI에만 연산 수행 (Output의 ROI 밖은 바꾸지 않음)
+ *                이웃 연산은 사각형 + halo를 잘라내 ApplyOperation 후 사각형 안쪽(Mask 화소)만 되돌려 씀
+ * @Input : nMode, nParam, *Input, nWidth, nHeight, *Roi
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int ProcessRoi(int nMode, int nParam, BYTE* Input, BYTE* Output, int nWidth, int nHeight, ROI* Roi)
+{
+	PROFILE_BEGIN();
+
+	int nHalo = GetRoiHalo(nMode, nParam);
+	int nHisto[256];
+	int nMaxCrop = 0, nPixels = 0, nResult = 1;
+	BYTE Lut[256];
+	BYTE *Crop = NULL, *CropOut = NULL, *CropTemp = NULL;
+
+	if (nHalo < 0 || 0 == ClipRoi(Roi, nWidth, nHeight)) {
+		nResult = 0;
+		goto CLEANUP;
+	}
+
+	// 히스토그램 기반 연산 : ROI 히스토그램 -> 변환표
+	if (5 == nMode || 7 == nMode || 8 == nMode) {
+		int nCount = GenerateRoiHistogram(Input, nWidth, Roi, nHisto);
+
+		if (0 == nCount)
+			goto CLEANUP;
+
+		BuildRoiLut(nMode, nHisto, nCount, Lut);
+
+		for (int i = 0; i < Roi->nRects; i++) {
+			ROI_RECT* r = &Roi->Rect[i];
+
+			for (int y = r->nTop; y < r->nTop + r->nHeight; y++)
+				for (int x = r->nLeft; x < r->nLeft + r->nWidth; x++)
+					if (NULL == Roi->Mask || Roi->Mask[y * nWidth + x])
+						Output[y * nWidth + x] = Lut[Input[y * nWidth + x]];
+
+			nPixels += r->nWidth * r->nHeight;
+		}
+
+		goto CLEANUP;
+	}
+
+	for (int i = 0; i < Roi->nRects; i++) {
+		int nCropWidth = (Roi->Rect[i].nWidth + 2 * nHalo) > nWidth ? nWidth : Roi->Rect[i].nWidth + 2 * nHalo;
+		int nCropHeight = (Roi->Rect[i].nHeight + 2 * nHalo) > nHeight ? nHeight : Roi->Rect[i].nHeight + 2 * nHalo;
+
+		if (nCropWidth * nCropHeight > nMaxCrop)
+			nMaxCrop = nCropWidth * nCropHeight;
+	}
+
+	Crop = (BYTE*)malloc(nMaxCrop);
+	CropOut = (BYTE*)malloc(nMaxCrop);
+	CropTemp = (BYTE*)malloc(nMaxCrop);
+
+	if (NULL == Crop || NULL == CropOut || NULL == CropTemp) {
+		nResult = 0;
+		goto CLEANUP;
+	}
+
+	for (int i = 0; i < Roi->nRects && nResult; i++) {
+		ROI_RECT* r = &Roi->Rect[i];
+		int x0 = r->nLeft - nHalo < 0 ? 0 : r->nLeft - nHalo;
+		int y0 = r->nTop - nHalo < 0 ? 0 : r->nTop - nHalo;
+		int x1 = r->nLeft + r->nWidth + nHalo > nWidth ? nWidth : r->nLeft + r->nWidth + nHalo;
+		int y1 = r->nTop + r->nHeight + nHalo > nHeight ? nHeight : r->nTop + r->nHeight + nHalo;
+		int nCropWidth = x1 - x0, nCropHeight = y1 - y0;
+
+		// 사각형 + halo 잘라내기 (이미지 경계에서는 halo 없이 전체 이미지와 같은 경계 처리)
+		for (int y = y0; y < y1; y++)
+			memcpy(&Crop[(y - y0) * nCropWidth], &Input[y * nWidth + x0], nCropWidth);
+
+		if (0 == ApplyOperation(nMode, nParam, Crop, CropOut, CropTemp, &nCropWidth, &nCropHeight) ||
+			nCropWidth != x1 - x0 || nCropHeight != y1 - y0) {
+			nResult = 0;
+			break;
+		}
+
+		for (int y = r->nTop; y < r->nTop + r->nHeight; y++) {
+			BYTE* pSrc = &CropOut[(y - y0) * nCropWidth + r->nLeft - x0];
+
+			if (NULL == Roi->Mask)
+				memcpy(&Output[y * nWidth + r->nLeft], pSrc, r->nWidth);
+			else
+				for (int x = 0; x < r->nWidth; x++)
+					if (Roi->Mask[y * nWidth + r->nLeft + x])
+						Output[y * nWidth + r->nLeft + x] = pSrc[x];
+		}
+
+		nPixels += nCropWidth * nCropHeight;
+	}
+
+CLEANUP:
+	free(Crop);
+	free(CropOut);
+	free(CropTemp);
+
+	PROFILE_END(nPixels, nPixels, nPixels);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : LoadRoiMask
+ * @Descriotion : 이미지와 같은 크기의 8비트 BMP Mask 파일에서 필요한 행만 읽음
+ * @Input : *Path, nWidth, nHeight, *RowNeeded
+ * @Output : Mask 버퍼 (실패 시 NULL)
+ */
+BYTE* LoadRoiMask(const char* Path, int nWidth, int nHeight, BYTE* RowNeeded)
+{
+	BITMAPFILEHEADER hf;
+	BITMAPINFOHEADER hInfo;
+	FILE* fp = NULL;
+	BYTE* Mask;
+
+	fopen_s(&fp, Path, "rb");
+	if (NULL == fp)
+		return NULL;
+
+	if (1 != fread(&hf, sizeof(BITMAPFILEHEADER), 1, fp) || 1 != fread(&hInfo, sizeof(BITMAPINFOHEADER), 1, fp) ||
+		hInfo.biWidth != nWidth || hInfo.biHeight != nHeight || 8 != hInfo.biBitCount) {
+		fclose(fp);
+		return NULL;
+	}
+
+	Mask = (BYTE*)calloc(nWidth * nHeight, 1);
+	if (NULL != Mask && ReadRoiRows(fp, hf.bfOffBits, Mask, nWidth, nHeight, RowNeeded) < 0) {
+		free(Mask);
+		Mask = NULL;
+	}
+
+	fclose(fp);
+
+	return Mask;
+}
+
+/*
+ * ver 1.8 : Template Matching (SSD, Zero-mean NCC)
+ * 영상의 합/제곱합 적분 영상으로 위치마다 정규화 항을 O(1)에 계산, 상관 항은 직접 계산(행 띠 병렬) 또는 큰 Template은 FFT
+ * Pyramid 최상위 Level에서 전체 탐색 후 후보 주변만 아래 Level로 내려가며 정밀화, 상위 K개 결과 반환
+ */
+
+#define MATCH_SSD			1
+#define MATCH_NCC			2
+#define MAX_MATCHES			64
+#define MATCH_MIN_TEMPLATE	8		// Pyramid 최상위 Level의 최소 Template 크기
+#define MATCH_MAX_LEVELS	4
+#define MATCH_REFINE		2		// 아래 Level 정밀화 탐색 반경
+
+#define MATCH_CROSS_AUTO	0		// 상관 항 계산 방식 : 측정 비용으로 선택
+#define MATCH_CROSS_DIRECT	1		// 항상 직접 계산 (DotProductRow)
+#define MATCH_CROSS_FFT		2		// 가능하면 항상 FFT
+
+typedef struct {
+	int nX, nY;				// Template 왼쪽 위 위치 (버퍼 좌표)
+	double dScore;			// SSD (작을수록 일치) 또는 NCC (-1 ~ 1, 클수록 일치)
+} MATCH_RESULT;
+
+typedef struct {
+	BYTE* Input;
+	int nWidth, nHeight;
+	BYTE* Template;
+	int nTWidth, nTHeight;
+	int nMethod;
+	long long* Sum;			// (nWidth + 1) x (nHeight + 1) 적분 영상
+	long long* SqSum;
+	double dTSum, dTSqSum;	// Template 합, 제곱합
+	double* Cross;			// FFT로 미리 계산한 상관 항 (NULL이면 직접 계산)
+	double* Score;			// (nWidth - nTWidth + 1) x (nHeight - nTHeight + 1)
+} MATCH_PARAM;
+
+/*
+ * @Function Name : BuildIntegralImages
+ * @Descriotion : 합, 제곱합 적분 영상 생성 (0행, 0열은 0)
+ * @Input : *Input, nWidth, nHeight
+ * @Output : *Sum, *SqSum
+ */
+void BuildIntegralImages(BYTE* Input, int nWidth, int nHeight, long long* Sum, long long* SqSum)
+{
+	int nStride = nWidth + 1;
+
+	memset(Sum, 0, sizeof(long long) * nStride);
+	memset(SqSum, 0, sizeof(long long) * nStride);
+
+	for (int y = 0; y < nHeight; y++) {
+		long long llRow = 0, llSqRow = 0;
+
+		Sum[(y + 1) * nStride] = 0;
+		SqSum[(y + 1) * nStride] = 0;
+
+		for (int x = 0; x < nWidth; x++) {
+			int v = Input[y * nWidth + x];
+
+			llRow += v;
+			llSqRow += v * v;
+			Sum[(y + 1) * nStride + x + 1] = Sum[y * nStride + x + 1] + llRow;
+			SqSum[(y + 1) * nStride + x + 1] = SqSum[y * nStride + x + 1] + llSqRow;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : DotProductRow
+ * @Descriotion : 두 행의 화소 곱의 합 (n <= 33000)
+ * @Input : *a, *b, n
+ * @Output : 곱의 합
+ */
+int DotProductRow(BYTE* a, BYTE* b, int n)
+{
+	int nSum = 0;
+	int i = 0;
+
+#ifdef USE_SSE2
+	__m128i vZero = _mm_setzero_si128();
+	__m128i vAcc = _mm_setzero_si128();
+
+	for (; i + 16 <= n; i += 16) {
+		__m128i vA = _mm_loadu_si128((__m128i*)&a[i]);
+		__m128i vB = _mm_loadu_si128((__m128i*)&b[i]);
+
+		vAcc = _mm_add_epi32(vAcc, _mm_madd_epi16(_mm_unpacklo_epi8(vA, vZero), _mm_unpacklo_epi8(vB, vZero)));
+		vAcc = _mm_add_epi32(vAcc, _mm_madd_epi16(_mm_unpackhi_epi8(vA, vZero), _mm_unpackhi_epi8(vB, vZero)));
+	}
+
+	vAcc = _mm_add_epi32(vAcc, _mm_srli_si128(vAcc, 8));
+	vAcc = _mm_add_epi32(vAcc, _mm_srli_si128(vAcc, 4));
+	nSum = _mm_cvtsi128_si32(vAcc);
+#endif
+
+	for (; i < n; i++)
+		nSum += a[i] * b[i];
+
+	return nSum;
+}
+
+/*
+ * @Function Name : MatchScore
+ * @Descriotion : 위치의 합/제곱합/상관 항으로 SSD 또는 Zero-mean NCC 계산
+ * @Input : nMethod, dSum, dSqSum, dCross, dTSum, dTSqSum, n
+ * @Output : 점수
+ */
+double MatchScore(int nMethod, double dSum, double dSqSum, double dCross, double dTSum, double dTSqSum, double n)
+{
+	double dVar, dTVar;
+
+	if (MATCH_SSD == nMethod)
+		return dSqSum - 2.0 * dCross + dTSqSum;
+
+	dVar = dSqSum - dSum * dSum / n;
+	dTVar = dTSqSum - dTSum * dTSum / n;
+
+	// 평탄한 영역은 상관을 정의할 수 없으므로 0
+	if (dVar <= 1e-9 || dTVar <= 1e-9)
+		return 0.0;
+
+	return (dCross - dSum * dTSum / n) / sqrt(dVar * dTVar);
+}
+
+/*
+ * @Function Name : MatchScoreBand
+ * @Descriotion : RunBands용 - 점수 행 [nStartRow, nEndRow)의 SSD/NCC 계산 (정규화 항은 적분 영상에서 O(1))
+ * @Input : pParam(MATCH_PARAM), nBand, nStartRow, nEndRow
+ * @Output : MATCH_PARAM->Score
+ */
+void MatchScoreBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	MATCH_PARAM* p = (MATCH_PARAM*)pParam;
+	int nOutWidth = p->nWidth - p->nTWidth + 1;
+	int nStride = p->nWidth + 1;
+	double n = (double)p->nTWidth * p->nTHeight;
+
+	for (int y = nStartRow; y < nEndRow; y++) {
+		for (int x = 0; x < nOutWidth; x++) {
+			int a = y * nStride + x, b = a + p->nTWidth;
+			int c = (y + p->nTHeight) * nStride + x, d = c + p->nTWidth;
+			double dSum = (double)(p->Sum[d] - p->Sum[b] - p->Sum[c] + p->Sum[a]);
+			double dSqSum = (double)(p->SqSum[d] - p->SqSum[b] - p->SqSum[c] + p->SqSum[a]);
+			double dCross;
+
+			if (NULL != p->Cross)
+				dCross = p->Cross[y * nOutWidth + x];
+			else {
+				long long llCross = 0;
+
+				for (int m = 0; m < p->nTHeight; m++)
+					llCross += DotProductRow(&p->Input[(y + m) * p->nWidth + x], &p->Template[m * p->nTWidth], p->nTWidth);
+				dCross = (double)llCross;
+			}
+
+			p->Score[y * nOutWidth + x] = MatchScore(p->nMethod, dSum, dSqSum, dCross, p->dTSum, p->dTSqSum, n);
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : FFTCrossCorrelation
+ * @Descriotion : 영상과 Template의 상관 항 Σ I(y+m, x+n) T(m, n) 을 FFT overlap-save로 계산 (유효 위치만)
+ * @Input : *Input, nWidth, nHeight, *Template, nTWidth, nTHeight
+ * @Output : *Cross ((nWidth - nTWidth + 1) x (nHeight - nTHeight + 1)), 성공 1, 실패 0
+ */
+int FFTCrossCorrelation(BYTE* Input, int nWidth, int nHeight, BYTE* Template, int nTWidth, int nTHeight, double* Cross)
+{
+	FFT_PLAN Plan;
+	int nKSize = nTWidth > nTHeight ? nTWidth : nTHeight;
+	int N = SelectFFTSize(nKSize);
+	int T = N - nKSize + 1;					// 타일당 유효 출력 크기 (순환 상관이 겹치지 않는 범위)
+	int nCols = N / 2 + 1;
+	int nOutWidth = nWidth - nTWidth + 1, nOutHeight = nHeight - nTHeight + 1;
+	double dScale;
+
+	// 선택할 FFT 크기가 없거나 Template이 영상보다 크면 호출자가 직접 방식으로 수행
+	if (N <= 0 || T <= 0 || nOutWidth <= 0 || nOutHeight <= 0)
+		return 0;
+
+	if (0 == CreateFFTPlan(&Plan, N))
+		return 0;
+
+	double* Tile = (double*)malloc(sizeof(double) * N * N);
+	COMPLEX* TemplateSpectrum = (COMPLEX*)malloc(sizeof(COMPLEX) * N * nCols);
+
+	if (NULL == Tile || NULL == TemplateSpectrum) {
+		free(Tile);
+		free(TemplateSpectrum);
+		DestroyFFTPlan(&Plan);
+		return 0;
+	}
+
+	// Template은 회전 없이 원점에 배치하고 스펙트럼의 켤레를 곱하여 상관 계산
+	memset(Tile, 0, sizeof(double) * N * N);
+	for (int m = 0; m < nTHeight; m++)
+		for (int n = 0; n < nTWidth; n++)
+			Tile[m * N + n] = Template[m * nTWidth + n];
+
+	FFT2D(Tile, nTHeight, TemplateSpectrum, &Plan);
+
+	dScale = 1.0 / ((double)N * Plan.nHalf);
+	for (int i = 0; i < N * nCols; i++) {
+		TemplateSpectrum[i].re *= dScale;
+		TemplateSpectrum[i].im *= -dScale;
+	}
+
+	for (int ty = 0; ty < nOutHeight; ty += T) {
+		int nRows = (nHeight - ty < N) ? nHeight - ty : N;
+
+		for (int tx = 0; tx < nOutWidth; tx += T) {
+			int nTileCols = (nWidth - tx < N) ? nWidth - tx : N;
+
+			memset(Tile, 0, sizeof(double) * N * N);
+			for (int y = 0; y < nRows; y++)
+				for (int x = 0; x < nTileCols; x++)
+					Tile[y * N + x] = Input[(ty + y) * nWidth + tx + x];
+
+			FFT2D(Tile, nRows, Plan.Spectrum, &Plan);
+
+			for (int i = 0; i < N * nCols; i++) {
+				COMPLEX a = Plan.Spectrum[i];
+				COMPLEX b = TemplateSpectrum[i];
+
+				Plan.Spectrum[i].re = a.re * b.re - a.im * b.im;
+				Plan.Spectrum[i].im = a.re * b.im + a.im * b.re;
+			}
+
+			InverseFFT2D(Plan.Spectrum, Tile, &Plan);
+
+			for (int y = 0; y < T && ty + y < nOutHeight; y++)
+				for (int x = 0; x < T && tx + x < nOutWidth; x++)
+					Cross[(ty + y) * nOutWidth + tx + x] = Tile[y * N + x];
+		}
+	}
+
+	free(Tile);
+	free(TemplateSpectrum);
+	DestroyFFTPlan(&Plan);
+
+	return 1;
+}
+
+/*
+ * @Function Name : UseFFTCorrelation
+ * @Descriotion : 측정된 Convolution 비용으로 FFT 상관이 (행 띠 병렬) 직접 계산보다 빠른지 판단
+ * @Input : nWidth, nHeight, nTWidth, nTHeight
+ * @Output : FFT 사용 1, 직접 방식 0
+ */
+int UseFFTCorrelation(int nWidth, int nHeight, int nTWidth, int nTHeight)
+{
+	int nKSize = nTWidth > nTHeight ? nTWidth : nTHeight;
+	double dDirect, dFFT;
+
+	if (nKSize <= 3 || nWidth < nTWidth || nHeight < nTHeight)
+		return 0;
+
+	// 4096 이하 FFT 크기로 처리할 수 없는 Template
+	if (0 == SelectFFTSize(nKSize))
+		return 0;
+
+	CalibrateConvolution();
+
+	dDirect = g_dDirectCost * (nWidth - nTWidth + 1) * (double)(nHeight - nTHeight + 1) * nTWidth * nTHeight / GetThreadCount();
+	dFFT = g_dFFTCost * EstimateFFTUnits(nWidth, nHeight, nKSize);
+
+	return dFFT < dDirect;
+}
+
+/*
+ * @Function Name : ComputeMatchScores
+ * @Descriotion : 모든 유효 위치의 SSD/NCC 점수 지도 계산
+ * @Input : *Input, nWidth, nHeight, *Template, nTWidth, nTHeight, nMethod, nCross(MATCH_CROSS_AUTO, MATCH_CROSS_DIRECT, MATCH_CROSS_FFT)
+ * @Output : *Score, 성공 1, 실패 0
+ */
+int ComputeMatchScores(BYTE* Input, int nWidth, int nHeight, BYTE* Template, int nTWidth, int nTHeight, int nMethod, int nCross, double* Score)
+{
+	MATCH_PARAM Param;
+	int nOutHeight = nHeight - nTHeight + 1;
+	int nResult = 1;
+
+	memset(&Param, 0, sizeof(Param));
+	Param.Input = Input;
+	Param.nWidth = nWidth;
+	Param.nHeight = nHeight;
+	Param.Template = Template;
+	Param.nTWidth = nTWidth;
+	Param.nTHeight = nTHeight;
+	Param.nMethod = nMethod;
+	Param.Score = Score;
+
+	for (int i = 0; i < nTWidth * nTHeight; i++) {
+		Param.dTSum += Template[i];
+		Param.dTSqSum += (double)Template[i] * Template[i];
+	}
+
+	Param.Sum = (long long*)malloc(sizeof(long long) * (nWidth + 1) * (nHeight + 1));
+	Param.SqSum = (long long*)malloc(sizeof(long long) * (nWidth + 1) * (nHeight + 1));
+
+	if (NULL == Param.Sum || NULL == Param.SqSum) {
+		nResult = 0;
+		goto CLEANUP;
+	}
+
+	BuildIntegralImages(Input, nWidth, nHeight, Param.Sum, Param.SqSum);
+
+	// FFT 버퍼 할당에 실패하면 직접 방식으로 수행
+	if (MATCH_CROSS_FFT == nCross || (MATCH_CROSS_AUTO == nCross && UseFFTCorrelation(nWidth, nHeight, nTWidth, nTHeight))) {
+		Param.Cross = (double*)malloc(sizeof(double) * (nWidth - nTWidth + 1) * nOutHeight);
+		if (NULL != Param.Cross && 0 == FFTCrossCorrelation(Input, nWidth, nHeight, Template, nTWidth, nTHeight, Param.Cross)) {
+			free(Param.Cross);
+			Param.Cross = NULL;
+		}
+	}
+
+	RunBands(MatchScoreBand, &Param, nOutHeight, GetBandCount(nOutHeight, 8));
+
+CLEANUP:
+	free(Param.Sum);
+	free(Param.SqSum);
+	free(Param.Cross);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : MatchRank
+ * @Descriotion : 방식에 관계없이 클수록 좋은 순위 값 (SSD는 부호 반전)
+ * @Input : nMethod, dScore
+ * @Output : 순위 값
+ */
+double MatchRank(int nMethod, double dScore)
+{
+	return MATCH_SSD == nMethod ? -dScore : dScore;
+}
+
+/*
+ * @Function Name : SelectTopMatches
+ * @Descriotion : 이미 고른 위치 주변(nSuppressX, nSuppressY 이내)을 제외하며 점수가 좋은 순으로 nK개 선택
+ * @Input : *Candidate, nCount, nMethod, nK, nSuppressX, nSuppressY
+ * @Output : *Results, 선택된 수
+ */
+int SelectTopMatches(MATCH_RESULT* Candidate, int nCount, int nMethod, int nK, int nSuppressX, int nSuppressY, MATCH_RESULT* Results)
+{
+	int nSelected = 0;
+
+	while (nSelected < nK) {
+		int nBest = -1;
+
+		for (int i = 0; i < nCount; i++) {
+			int bSuppressed = 0;
+
+			for (int j = 0; j < nSelected && !bSuppressed; j++)
+				bSuppressed = abs(Candidate[i].nX - Results[j].nX) < nSuppressX && abs(Candidate[i].nY - Results[j].nY) < nSuppressY;
+
+			if (!bSuppressed && (nBest < 0 || MatchRank(nMethod, Candidate[i].dScore) > MatchRank(nMethod, Candidate[nBest].dScore)))
+				nBest = i;
+		}
+
+		if (nBest < 0)
+			break;
+
+		Results[nSelected++] = Candidate[nBest];
+	}
+
+	return nSelected;
+}
+
+/*
+ * @Function Name : SelectTopScores
+ * @Descriotion : 점수 지도에서 억제 창을 적용하여 상위 nK개 위치 선택
+ * @Input : *Score, nOutWidth, nOutHeight, nMethod, nK, nSuppressX, nSuppressY
+ * @Output : *Results, 선택된 수
+ */
+int SelectTopScores(double* Score, int nOutWidth, int nOutHeight, int nMethod, int nK, int nSuppressX, int nSuppressY, MATCH_RESULT* Results)
+{
+	int nSelected = 0;
+
+	while (nSelected < nK) {
+		int nBest = -1;
+
+		for (int i = 0; i < nOutWidth * nOutHeight; i++) {
+			int bSuppressed = 0;
+
+			if (nBest >= 0 && MatchRank(nMethod, Score[i]) <= MatchRank(nMethod, Score[nBest]))
+				continue;
+
+			for (int j = 0; j < nSelected && !bSuppressed; j++)
+				bSuppressed = abs(i % nOutWidth - Results[j].nX) < nSuppressX && abs(i / nOutWidth - Results[j].nY) < nSuppressY;
+
+			if (!bSuppressed)
+				nBest = i;
+		}
+
+		if (nBest < 0)
+			break;
+
+		Results[nSelected].nX = nBest % nOutWidth;
+		Results[nSelected].nY = nBest / nOutWidth;
+		Results[nSelected].dScore = Score[nBest];
+		nSelected++;
+	}
+
+	return nSelected;
+}
+
+/*
+ * @Function Name : MatchAt
+ * @Descriotion : 한 위치의 점수를 직접 계산 (정밀화 단계용)
+ * @Input : *Input, nWidth, *Template, nTWidth, nTHeight, nMethod, dTSum, dTSqSum, x, y
+ * @Output : 점수
+ */
+double MatchAt(BYTE* Input, int nWidth, BYTE* Template, int nTWidth, int nTHeight, int nMethod, double dTSum, double dTSqSum, int x, int y)
+{
+	long long llSum = 0, llSqSum = 0, llCross = 0;
+
+	for (int m = 0; m < nTHeight; m++) {
+		BYTE* pRow = &Input[(y + m) * nWidth + x];
+
+		for (int n = 0; n < nTWidth; n++) {
+			llSum += pRow[n];
+			llSqSum += pRow[n] * pRow[n];
+		}
+		llCross += DotProductRow(pRow, &Template[m * nTWidth], nTWidth);
+	}
+
+	return MatchScore(nMethod, (double)llSum, (double)llSqSum, (double)llCross, dTSum, dTSqSum, (double)nTWidth * nTHeight);
+}
+
+/*
+ * @Function Name : MatchTemplate
+ * @Descriotion : Coarse-to-fine Template Matching
+ *                최상위 Level 전체 점수 지도에서 후보를 고르고, 아래 Level마다 2배 위치 주변 +-MATCH_REFINE만 탐색
+ * @Input : *Input, nWidth, nHeight, *Template, nTWidth, nTHeight, nMethod, nK (1 ~ MAX_MATCHES)
+ * @Output : *Results, 찾은 수 (실패 시 -1)
+ */
+int MatchTemplate(BYTE* Input, int nWidth, int nHeight, BYTE* Template, int nTWidth, int nTHeight, int nMethod, int nK, MATCH_RESULT* Results)
+{
+	PROFILE_BEGIN();
+
+	IMAGE_PYRAMID Image, Templ;
+	MATCH_RESULT Candidate[MAX_MATCHES];
+	double* Score = NULL;
+	int nLevels = 1, nCandidates, nTop, nFound = -1;
+
+	// 실패 경로에서도 CLEANUP의 Destroy가 안전하도록 비워 둠
+	memset(&Image, 0, sizeof(IMAGE_PYRAMID));
+	memset(&Templ, 0, sizeof(IMAGE_PYRAMID));
+
+	if (nTWidth < 1 || nTHeight < 1 || nTWidth > nWidth || nTHeight > nHeight || nK < 1 || nK > MAX_MATCHES)
+		goto CLEANUP;
+
+	// Template이 MATCH_MIN_TEMPLATE보다 작아지지 않는 범위에서 Level 수 결정
+	while (nLevels < MATCH_MAX_LEVELS && (nTWidth >> nLevels) >= MATCH_MIN_TEMPLATE && (nTHeight >> nLevels) >= MATCH_MIN_TEMPLATE)
+		nLevels++;
+
+	if (0 == BuildGaussianPyramid(Input, nWidth, nHeight, nLevels, &Image))
+		goto CLEANUP;
+	if (0 == BuildGaussianPyramid(Template, nTWidth, nTHeight, nLevels, &Templ))
+		goto CLEANUP;
+
+	nTop = (Image.nLevels < Templ.nLevels ? Image.nLevels : Templ.nLevels) - 1;
+	while (nTop > 0 && (Templ.nWidth[nTop] > Image.nWidth[nTop] || Templ.nHeight[nTop] > Image.nHeight[nTop]))
+		nTop--;
+
+	// 최상위 Level 전체 탐색 : 정밀화 중 순위가 바뀔 수 있으므로 nK의 4배 후보 유지
+	{
+		int nOutWidth = Image.nWidth[nTop] - Templ.nWidth[nTop] + 1;
+		int nOutHeight = Image.nHeight[nTop] - Templ.nHeight[nTop] + 1;
+
+		Score = (double*)malloc(sizeof(double) * nOutWidth * nOutHeight);
+		if (NULL == Score || 0 == ComputeMatchScores(Image.Level[nTop], Image.nWidth[nTop], Image.nHeight[nTop],
+			Templ.Level[nTop], Templ.nWidth[nTop], Templ.nHeight[nTop], nMethod, MATCH_CROSS_AUTO, Score))
+			goto CLEANUP;
+
+		nCandidates = SelectTopScores(Score, nOutWidth, nOutHeight, nMethod, nK * 4 < MAX_MATCHES ? nK * 4 : MAX_MATCHES,
+			(Templ.nWidth[nTop] + 3) / 4, (Templ.nHeight[nTop] + 3) / 4, Candidate);
+	}
+
+	// 아래 Level로 정밀화
+	for (int l = nTop - 1; l >= 0; l--) {
+		int nOutWidth = Image.nWidth[l] - Templ.nWidth[l] + 1;
+		int nOutHeight = Image.nHeight[l] - Templ.nHeight[l] + 1;
+		double dTSum = 0.0, dTSqSum = 0.0;
+
+		for (int i = 0; i < Templ.nWidth[l] * Templ.nHeight[l]; i++) {
+			dTSum += Templ.Level[l][i];
+			dTSqSum += (double)Templ.Level[l][i] * Templ.Level[l][i];
+		}
+
+		for (int c = 0; c < nCandidates; c++) {
+			int cx = Candidate[c].nX * 2, cy = Candidate[c].nY * 2;
+			int bFirst = 1;
+
+			for (int y = cy - MATCH_REFINE; y <= cy + MATCH_REFINE; y++) {
+				for (int x = cx - MATCH_REFINE; x <= cx + MATCH_REFINE; x++) {
+					double dScore;
+
+					if (x < 0 || y < 0 || x >= nOutWidth || y >= nOutHeight)
+						continue;
+
+					dScore = MatchAt(Image.Level[l], Image.nWidth[l], Templ.Level[l], Templ.nWidth[l], Templ.nHeight[l], nMethod, dTSum, dTSqSum, x, y);
+					if (bFirst || MatchRank(nMethod, dScore) > MatchRank(nMethod, Candidate[c].dScore)) {
+						Candidate[c].nX = x;
+						Candidate[c].nY = y;
+						Candidate[c].dScore = dScore;
+						bFirst = 0;
+					}
+				}
+			}
+		}
+	}
+
+	// 정밀화 후 같은 위치로 모인 후보 제거
+	nFound = SelectTopMatches(Candidate, nCandidates, nMethod, nK, (nTWidth + 1) / 2, (nTHeight + 1) / 2, Results);
+
+CLEANUP:
+	free(Score);
+	DestroyGaussianPyramid(&Image);
+	DestroyGaussianPyramid(&Templ);
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight + nTWidth * nTHeight, 0);
+
+	return nFound;
+}
+
+/*
+ * @Function Name : LoadGrayImage
+ * @Descriotion : 8비트 BMP 파일의 화소를 읽음 (Template 등 보조 입력용)
+ * @Input : *Path
+ * @Output : 화소 버퍼 (실패 시 NULL), *pWidth, *pHeight
+ */
+BYTE* LoadGrayImage(const char* Path, int* pWidth, int* pHeight)
+{
+	BITMAPFILEHEADER hf;
+	BITMAPINFOHEADER hInfo;
+	FILE* fp = NULL;
+	BYTE* Image = NULL;
+
+	fopen_s(&fp, Path, "rb");
+	if (NULL == fp)
+		return NULL;
+
+	if (1 == fread(&hf, sizeof(BITMAPFILEHEADER), 1, fp) && 1 == fread(&hInfo, sizeof(BITMAPINFOHEADER), 1, fp) &&
+		8 == hInfo.biBitCount && hInfo.biWidth > 0 && hInfo.biHeight > 0 && 0 == fseek(fp, hf.bfOffBits, SEEK_SET)) {
+		Image = (BYTE*)malloc(hInfo.biWidth * hInfo.biHeight);
+
+		if (NULL != Image && (size_t)hInfo.biWidth * hInfo.biHeight != fread(Image, 1, (size_t)hInfo.biWidth * hInfo.biHeight, fp)) {
+			free(Image);
+			Image = NULL;
+		}
+	}
+
+	fclose(fp);
+
+	if (NULL != Image) {
+		*pWidth = hInfo.biWidth;
+		*pHeight = hInfo.biHeight;
+	}
+
+	return Image;
+}
+
+/*
+ * @Function Name : DrawRectangle
+ * @Descriotion : 사각형 테두리를 bValue로 그림
+ * @Input : nWidth, nHeight, nLeft, nTop, nRectWidth, nRectHeight, bValue
+ * @Output : *Image
+ */
+void DrawRectangle(BYTE* Image, int nWidth, int nHeight, int nLeft, int nTop, int nRectWidth, int nRectHeight, BYTE bValue)
+{
+	int nRight = nLeft + nRectWidth - 1, nBottom = nTop + nRectHeight - 1;
+
+	for (int x = nLeft; x <= nRight; x++) {
+		if (x < 0 || x >= nWidth)
+			continue;
+		if (nTop >= 0 && nTop < nHeight)
+			Image[nTop * nWidth + x] = bValue;
+		if (nBottom >= 0 && nBottom < nHeight)
+			Image[nBottom * nWidth + x] = bValue;
+	}
+
+	for (int y = nTop; y <= nBottom; y++) {
+		if (y < 0 || y >= nHeight)
+			continue;
+		if (nLeft >= 0 && nLeft < nWidth)
+			Image[y * nWidth + nLeft] = bValue;
+		if (nRight >= 0 && nRight < nWidth)
+			Image[y * nWidth + nRight] = bValue;
+	}
+
+	return;
+}
+
+/*
+ * ver 1.9 : Bilateral Filter (가장자리 보존 평활화)
+ * 정확 방식 : 원형 창의 공간 가중치 표와 밝기 차이 256단계 범위 가중치 LUT (탭마다 exp() 없음), 4화소 SSE2, 행 띠 병렬
+ * 큰 반경 : Bilateral Grid 근사 (공간 sigma_s, 밝기 sigma_r 간격 격자에 누적 -> 격자 Gaussian -> 삼선형 보간), 반경과 무관한 시간
+ */
+
+#define BILATERAL_EXACT_MAX_RADIUS	5		// 이보다 큰 반경은 Bilateral Grid 사용
+#define BILATERAL_GRID_PAD			2		// 격자 경계 여유 (5-tap Gaussian 반경)
+
+typedef struct {
+	BYTE* Padded;			// 경계를 반경만큼 복제한 입력 ((nWidth + 2r) x (nHeight + 2r))
+	BYTE* Output;
+	int nWidth, nHeight, nRadius;
+	int nTaps;
+	int* TapOffset;			// Padded 안에서 중심 대비 오프셋
+	float* TapWeight;		// 공간 가중치
+	float RangeLut[256];	// 밝기 차이별 범위 가중치
+	int bScalar;			// 1이면 SSE2 경로 없이 Scalar로만 계산 (차등 검증 기준)
+} BILATERAL_PARAM;
+
+typedef struct {
+	float* Grid;			// (gz, gy, gx)마다 (가중 밝기 합, 가중치 합)
+	float* Scratch;			// 띠마다 선 하나 작업 버퍼
+	int nScratch;			// 띠당 작업 버퍼 크기 (float 수)
+	int nGridWidth, nGridHeight, nGridDepth;
+	BYTE* Input;
+	BYTE* Output;
+	int nWidth, nHeight;
+	double dSigmaSpace, dSigmaRange;
+} BILATERAL_GRID;
+
+/*
+ * @Function Name : BilateralBand
+ * @Descriotion : RunBands용 - 정확 Bilateral Filter의 출력 행 [nStartRow, nEndRow) 계산
+ * @Input : pParam(BILATERAL_PARAM), nBand, nStartRow, nEndRow
+ * @Output : BILATERAL_PARAM->Output
+ */
+void BilateralBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	BILATERAL_PARAM* p = (BILATERAL_PARAM*)pParam;
+	int nStride = p->nWidth + 2 * p->nRadius;
+
+	for (int y = nStartRow; y < nEndRow; y++) {
+		BYTE* pCenter = &p->Padded[(y + p->nRadius) * nStride + p->nRadius];
+		BYTE* pOut = &p->Output[y * p->nWidth];
+		int x = 0;
+
+#ifdef USE_SSE2
+		for (; 0 == p->bScalar && x + 4 <= p->nWidth; x += 4) {
+			__m128 vSum = _mm_setzero_ps(), vWeightSum = _mm_setzero_ps();
+			__m128i vResult;
+
+			for (int t = 0; t < p->nTaps; t++) {
+				BYTE* pTap = &pCenter[x + p->TapOffset[t]];
+				__m128 vSpace = _mm_set1_ps(p->TapWeight[t]);
+				__m128 vValue = _mm_set_ps(pTap[3], pTap[2], pTap[1], pTap[0]);
+				__m128 vRange = _mm_set_ps(p->RangeLut[abs(pTap[3] - pCenter[x + 3])], p->RangeLut[abs(pTap[2] - pCenter[x + 2])],
+					p->RangeLut[abs(pTap[1] - pCenter[x + 1])], p->RangeLut[abs(pTap[0] - pCenter[x])]);
+				__m128 vWeight = _mm_mul_ps(vSpace, vRange);
+
+				vSum = _mm_add_ps(vSum, _mm_mul_ps(vWeight, vValue));
+				vWeightSum = _mm_add_ps(vWeightSum, vWeight);
+			}
+
+			// 중심 탭 가중치가 1이므로 가중치 합은 0이 아님
+			// _mm_cvtps_epi32는 짝수 반올림이므로 Scalar 꼬리와 같이 0.5를 더하고 버림
+			vResult = _mm_cvttps_epi32(_mm_add_ps(_mm_div_ps(vSum, vWeightSum), _mm_set1_ps(0.5f)));
+			vResult = _mm_packs_epi32(vResult, vResult);
+			vResult = _mm_packus_epi16(vResult, vResult);
+			*(int*)&pOut[x] = _mm_cvtsi128_si32(vResult);
+		}
+#endif
+
+		for (; x < p->nWidth; x++) {
+			float fSum = 0.0f, fWeightSum = 0.0f;
+
+			for (int t = 0; t < p->nTaps; t++) {
+				BYTE bValue = pCenter[x + p->TapOffset[t]];
+				float fWeight = p->TapWeight[t] * p->RangeLut[abs(bValue - pCenter[x])];
+
+				fSum += fWeight * bValue;
+				fWeightSum += fWeight;
+			}
+
+			pOut[x] = (BYTE)(fSum / fWeightSum + 0.5f);
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : BilateralFilterExact
+ * @Descriotion : 반경 nRadius 원형 창의 정확 Bilateral Filter (경계는 복제)
+ * @Input : *Input, nWidth, nHeight, nRadius, dSigmaSpace, dSigmaRange, bScalar(1이면 SSE2 미사용)
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int BilateralFilterExact(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nRadius, double dSigmaSpace, double dSigmaRange, int bScalar)
+{
+	BILATERAL_PARAM Param;
+	int r = nRadius;
+	int nStride = nWidth + 2 * r;
+	int nDiameter = 2 * r + 1;
+
+	memset(&Param, 0, sizeof(Param));
+	Param.Padded = (BYTE*)malloc((size_t)nStride * (nHeight + 2 * r));
+	Param.TapOffset = (int*)malloc(sizeof(int) * nDiameter * nDiameter);
+	Param.TapWeight = (float*)malloc(sizeof(float) * nDiameter * nDiameter);
+
+	if (NULL == Param.Padded || NULL == Param.TapOffset || NULL == Param.TapWeight) {
+		free(Param.Padded);
+		free(Param.TapOffset);
+		free(Param.TapWeight);
+		return 0;
+	}
+
+	// 경계 복제 입력
+	for (int y = 0; y < nHeight + 2 * r; y++) {
+		int sy = y - r < 0 ? 0 : (y - r >= nHeight ? nHeight - 1 : y - r);
+		BYTE* pDst = &Param.Padded[y * nStride];
+
+		memset(pDst, Input[sy * nWidth], r);
+		memcpy(&pDst[r], &Input[sy * nWidth], nWidth);
+		memset(&pDst[r + nWidth], Input[sy * nWidth + nWidth - 1], r);
+	}
+
+	// 원형 창의 공간 가중치 표
+	for (int dy = -r; dy <= r; dy++) {
+		for (int dx = -r; dx <= r; dx++) {
+			if (dx * dx + dy * dy > r * r)
+				continue;
+
+			Param.TapOffset[Param.nTaps] = dy * nStride + dx;
+			Param.TapWeight[Param.nTaps] = (float)exp(-(dx * dx + dy * dy) / (2.0 * dSigmaSpace * dSigmaSpace));
+			Param.nTaps++;
+		}
+	}
+
+	// 밝기 차이 0 ~ 255의 범위 가중치 LUT
+	for (int d = 0; d < 256; d++)
+		Param.RangeLut[d] = (float)exp(-(d * d) / (2.0 * dSigmaRange * dSigmaRange));
+
+	Param.Output = Output;
+	Param.nWidth = nWidth;
+	Param.nHeight = nHeight;
+	Param.nRadius = r;
+	Param.bScalar = bScalar;
+
+	RunBands(BilateralBand, &Param, nHeight, GetBandCount(nHeight, 8));
+
+	free(Param.Padded);
+	free(Param.TapOffset);
+	free(Param.TapWeight);
+
+	return 1;
+}
+
+/*
+ * @Function Name : BlurGridLine
+ * @Descriotion : 격자 한 선(nCount 칸, 칸 간격 nStep float)에 [1 4 6 4 1] / 16 적용 (선 끝 밖은 0)
+ * @Input : *Line, nCount, nStep, *Scratch (2 x nCount)
+ * @Output : *Line
+ */
+void BlurGridLine(float* Line, int nCount, int nStep, float* Scratch)
+{
+	for (int i = 0; i < nCount; i++) {
+		Scratch[2 * i] = Line[i * nStep];
+		Scratch[2 * i + 1] = Line[i * nStep + 1];
+	}
+
+	for (int i = 0; i < nCount; i++) {
+		float fValue = 6.0f * Scratch[2 * i], fWeight = 6.0f * Scratch[2 * i + 1];
+
+		if (i - 1 >= 0)     { fValue += 4.0f * Scratch[2 * (i - 1)]; fWeight += 4.0f * Scratch[2 * (i - 1) + 1]; }
+		if (i + 1 < nCount) { fValue += 4.0f * Scratch[2 * (i + 1)]; fWeight += 4.0f * Scratch[2 * (i + 1) + 1]; }
+		if (i - 2 >= 0)     { fValue += Scratch[2 * (i - 2)];        fWeight += Scratch[2 * (i - 2) + 1]; }
+		if (i + 2 < nCount) { fValue += Scratch[2 * (i + 2)];        fWeight += Scratch[2 * (i + 2) + 1]; }
+
+		Line[i * nStep] = fValue / 16.0f;
+		Line[i * nStep + 1] = fWeight / 16.0f;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : BlurGridXYBand
+ * @Descriotion : RunBands용 - 밝기 평면 [nStartRow, nEndRow)마다 격자 가로, 세로 방향 Gaussian
+ * @Input : pParam(BILATERAL_GRID), nBand, nStartRow, nEndRow
+ * @Output : BILATERAL_GRID->Grid
+ */
+void BlurGridXYBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	BILATERAL_GRID* g = (BILATERAL_GRID*)pParam;
+	float* Scratch = &g->Scratch[nBand * g->nScratch];
+
+	for (int z = nStartRow; z < nEndRow; z++) {
+		float* pPlane = &g->Grid[(size_t)z * g->nGridHeight * g->nGridWidth * 2];
+
+		for (int y = 0; y < g->nGridHeight; y++)
+			BlurGridLine(&pPlane[y * g->nGridWidth * 2], g->nGridWidth, 2, Scratch);
+		for (int x = 0; x < g->nGridWidth; x++)
+			BlurGridLine(&pPlane[x * 2], g->nGridHeight, g->nGridWidth * 2, Scratch);
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : BlurGridZBand
+ * @Descriotion : RunBands용 - 격자 행 [nStartRow, nEndRow)마다 밝기 방향 Gaussian
+ * @Input : pParam(BILATERAL_GRID), nBand, nStartRow, nEndRow
+ * @Output : BILATERAL_GRID->Grid
+ */
+void BlurGridZBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	BILATERAL_GRID* g = (BILATERAL_GRID*)pParam;
+	float* Scratch = &g->Scratch[nBand * g->nScratch];
+	int nPlane = g->nGridHeight * g->nGridWidth * 2;
+
+	for (int y = nStartRow; y < nEndRow; y++)
+		for (int x = 0; x < g->nGridWidth; x++)
+			BlurGridLine(&g->Grid[(y * g->nGridWidth + x) * 2], g->nGridDepth, nPlane, Scratch);
+
+	return;
+}
+
+/*
+ * @Function Name : SliceGridBand
+ * @Descriotion : RunBands용 - 출력 행 [nStartRow, nEndRow)를 격자에서 삼선형 보간하여 (가중 밝기 합 / 가중치 합) 계산
+ * @Input : pParam(BILATERAL_GRID), nBand, nStartRow, nEndRow
+ * @Output : BILATERAL_GRID->Output
+ */
+void SliceGridBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	BILATERAL_GRID* g = (BILATERAL_GRID*)pParam;
+	int nRow = g->nGridWidth * 2;
+	int nPlane = g->nGridHeight * nRow;
+
+	for (int y = nStartRow; y < nEndRow; y++) {
+		double gy = y / g->dSigmaSpace + BILATERAL_GRID_PAD;
+		int y0 = (int)gy;
+		float fy = (float)(gy - y0);
+
+		for (int x = 0; x < g->nWidth; x++) {
+			BYTE bValue = g->Input[y * g->nWidth + x];
+			double gx = x / g->dSigmaSpace + BILATERAL_GRID_PAD;
+			double gz = bValue / g->dSigmaRange + BILATERAL_GRID_PAD;
+			int x0 = (int)gx, z0 = (int)gz;
+			float fx = (float)(gx - x0), fz = (float)(gz - z0);
+			float* p = &g->Grid[(size_t)z0 * nPlane + y0 * nRow + x0 * 2];
+			float fValue = 0.0f, fWeight = 0.0f;
+
+			// 주변 8칸 삼선형 보간
+			for (int dz = 0; dz < 2; dz++) {
+				for (int dy = 0; dy < 2; dy++) {
+					float* q = &p[dz * nPlane + dy * nRow];
+					float w = (dz ? fz : 1.0f - fz) * (dy ? fy : 1.0f - fy);
+
+					fValue += w * ((1.0f - fx) * q[0] + fx * q[2]);
+					fWeight += w * ((1.0f - fx) * q[1] + fx * q[3]);
+				}
+			}
+
+			g->Output[y * g->nWidth + x] = fWeight > 1e-6f ? (BYTE)(fValue / fWeight + 0.5f) : bValue;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : BilateralGrid
+ * @Descriotion : Bilateral Grid 근사 (Chen, Paris, Durand) - 화소를 (x / sigma_s, y / sigma_s, 밝기 / sigma_r) 격자에 누적,
+ *                격자에서 3방향 Gaussian 후 각 화소 위치에서 보간, 시간은 반경과 무관
+ * @Input : *Input, nWidth, nHeight, dSigmaSpace, dSigmaRange
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int BilateralGrid(BYTE* Input, BYTE* Output, int nWidth, int nHeight, double dSigmaSpace, double dSigmaRange)
+{
+	BILATERAL_GRID Grid;
+	int nBands, nMaxLine;
+
+	if (dSigmaSpace < 1.0)
+		dSigmaSpace = 1.0;
+	if (dSigmaRange < 1.0)
+		dSigmaRange = 1.0;
+
+	memset(&Grid, 0, sizeof(Grid));
+	Grid.Input = Input;
+	Grid.Output = Output;
+	Grid.nWidth = nWidth;
+	Grid.nHeight = nHeight;
+	Grid.dSigmaSpace = dSigmaSpace;
+	Grid.dSigmaRange = dSigmaRange;
+	Grid.nGridWidth = (int)((nWidth - 1) / dSigmaSpace) + 2 + 2 * BILATERAL_GRID_PAD;
+	Grid.nGridHeight = (int)((nHeight - 1) / dSigmaSpace) + 2 + 2 * BILATERAL_GRID_PAD;
+	Grid.nGridDepth = (int)(255 / dSigmaRange) + 2 + 2 * BILATERAL_GRID_PAD;
+
+	nMaxLine = Grid.nGridWidth;
+	if (Grid.nGridHeight > nMaxLine)
+		nMaxLine = Grid.nGridHeight;
+	if (Grid.nGridDepth > nMaxLine)
+		nMaxLine = Grid.nGridDepth;
+	Grid.nScratch = 2 * nMaxLine;
+
+	nBands = GetThreadCount();
+	Grid.Grid = (float*)calloc((size_t)Grid.nGridWidth * Grid.nGridHeight * Grid.nGridDepth * 2, sizeof(float));
+	Grid.Scratch = (float*)malloc(sizeof(float) * Grid.nScratch * nBands);
+
+	if (NULL == Grid.Grid || NULL == Grid.Scratch) {
+		free(Grid.Grid);
+		free(Grid.Scratch);
+		return 0;
+	}
+
+	// 누적 (가장 가까운 칸)
+	for (int y = 0; y < nHeight; y++) {
+		int gy = (int)(y / dSigmaSpace + 0.5) + BILATERAL_GRID_PAD;
+
+		for (int x = 0; x < nWidth; x++) {
+			BYTE bValue = Input[y * nWidth + x];
+			int gx = (int)(x / dSigmaSpace + 0.5) + BILATERAL_GRID_PAD;
+			int gz = (int)(bValue / dSigmaRange + 0.5) + BILATERAL_GRID_PAD;
+			float* p = &Grid.Grid[(((size_t)gz * Grid.nGridHeight + gy) * Grid.nGridWidth + gx) * 2];
+
+			p[0] += bValue;
+			p[1] += 1.0f;
+		}
+	}
+
+	RunBands(BlurGridXYBand, &Grid, Grid.nGridDepth, GetBandCount(Grid.nGridDepth, 1));
+	RunBands(BlurGridZBand, &Grid, Grid.nGridHeight, GetBandCount(Grid.nGridHeight, 1));
+	RunBands(SliceGridBand, &Grid, nHeight, GetBandCount(nHeight, 8));
+
+	free(Grid.Grid);
+	free(Grid.Scratch);
+
+	return 1;
+}
+
+/*
+ * @Function Name : BilateralFilter
+ * @Descriotion : Bilateral Filter - 반경이 BILATERAL_EXACT_MAX_RADIUS 이하이면 정확 방식, 크면 Bilateral Grid (sigma_s = 반경 / 2)
+ * @Input : *Input, nWidth, nHeight, nRadius, dSigmaRange
+ * @Output : *Output, 성공 1, 실패 0
+ */
+int BilateralFilter(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nRadius, double dSigmaRange)
+{
+	PROFILE_BEGIN();
+
+	double dSigmaSpace = nRadius / 2.0;
+	int nResult = 0;
+
+	if (nRadius < 1 || dSigmaRange <= 0.0)
+		nResult = 0;
+	else if (nRadius <= BILATERAL_EXACT_MAX_RADIUS)
+		nResult = BilateralFilterExact(Input, Output, nWidth, nHeight, nRadius, dSigmaSpace, dSigmaRange, 0);
+	else
+		nResult = BilateralGrid(Input, Output, nWidth, nHeight, dSigmaSpace, dSigmaRange);
+
+	PROFILE_END(nWidth * nHeight, nWidth * nHeight, nWidth * nHeight);
+
+	return nResult;
+}
+
+/*
+ * ver 2.0 : 일괄(Batch) 비동기 파일 입출력
+ * 목록 파일의 이미지들을 I/O Completion Port로 여러 개 동시에 읽고/쓰면서 도착한 프레임부터 연산
+ * 파일마다 헤더 + 팔레트 + 화소를 한 번의 ReadFile로, 결과도 한 번의 WriteFile로 처리
+ * 슬롯 버퍼는 시작 시 한 번 페이지 정렬로 할당하여 재사용하고, 더 큰 파일이 오면 그 슬롯만 늘림 (FILE_FLAG_NO_BUFFERING 사용 가능)
+ * Completion Port를 만들 수 없으면 파일 단위로 나눈 스레드에서 동기 입출력 (연산은 두 경로 모두 한 번에 하나씩)
+ */
+
+#define BATCH_MAX_INFLIGHT		8					// 동시에 진행하는 파일 수
+#define BATCH_FRAME_SIZE		(8 * 1024 * 1024)	// 슬롯 버퍼 초기 크기
+#define BATCH_MAX_FILE_SIZE		(1024 * 1024 * 1024)	// 파일 최대 크기 (한 번의 ReadFile 길이)
+#define BATCH_SECTOR_SIZE		4096				// NO_BUFFERING 읽기 길이 정렬 단위
+#define BATCH_HEADER_SIZE		(14 + 40 + 4 * 256)	// 출력 파일 헤더 + 팔레트
+#define BATCH_OUTPUT_DIR		"../batch"
+
+#define BATCH_IDLE				0
+#define BATCH_READING			1
+#define BATCH_WRITING			2
+
+typedef struct {
+	OVERLAPPED Overlapped;		// 첫 멤버 (완료 통지의 OVERLAPPED 주소 = 슬롯 주소)
+	HANDLE hFile;
+	int nState;
+	int nFile;					// 처리 중인 목록 번호
+	DWORD dwFileSize;
+	BYTE* Buffer;				// 읽기 버퍼 (파일 전체)
+	BYTE* OutBuffer;			// 쓰기 버퍼 (헤더 + 팔레트 + 결과 화소)
+	DWORD dwCapacity;			// Buffer 크기
+	DWORD dwOutCapacity;		// OutBuffer 크기
+} BATCH_SLOT;
+
+typedef struct {
+	char (*Path)[MAX_PATH];
+	int nFiles, nNext;
+	int nMode, nParam;
+	int bDirect;				// 읽기에 FILE_FLAG_NO_BUFFERING 사용
+	HANDLE hPort;
+	BATCH_SLOT Slot[BATCH_MAX_INFLIGHT];
+	BYTE* Temp;					// 연산 임시 버퍼 (연산은 한 번에 하나씩만 수행)
+	DWORD dwTempCapacity;
+	CRITICAL_SECTION Lock;		// 대체 경로의 연산 직렬화 (진단/계측 기록은 잠금 없는 전역 배열)
+	volatile LONG lDone, lFailed;
+	volatile LONGLONG llBytesRead, llBytesWritten;
+} BATCH_JOB;
+
+/*
+ * @Function Name : LoadBatchList
+ * @Descriotion : 한 줄에 하나씩 이미지 경로가 적힌 목록 파일 읽기 (빈 줄 무시)
+ * @Input : *ListPath
+ * @Output : 경로 배열 (실패 시 NULL), *pCount
+ */
+char (*LoadBatchList(const char* ListPath, int* pCount))[MAX_PATH]
+{
+	char Line[MAX_PATH];
+	char (*Path)[MAX_PATH] = NULL;
+	int nCount = 0, nCap = 0;
+	FILE* fp = NULL;
+
+	fopen_s(&fp, ListPath, "r");
+	if (NULL == fp)
+		return NULL;
+
+	while (NULL != fgets(Line, sizeof(Line), fp)) {
+		Line[strcspn(Line, "\r\n")] = 0;
+		if (0 == Line[0])
+			continue;
+
+		if (nCount == nCap) {
+			char (*NewPath)[MAX_PATH] = realloc(Path, sizeof(*Path) * (nCap ? nCap * 2 : 64));
+
+			if (NULL == NewPath) {
+				free(Path);
+				fclose(fp);
+				return NULL;
+			}
+			Path = NewPath;
+			nCap = nCap ? nCap * 2 : 64;
+		}
+
+		strcpy_s(Path[nCount++], MAX_PATH, Line);
+	}
+
+	fclose(fp);
+	*pCount = nCount;
+
+	return Path;
+}
+
+/*
+ * @Function Name : GetBatchOutputPath
+ * @Descriotion : 입력 경로의 파일 이름으로 BATCH_OUTPUT_DIR 아래 출력 경로 생성
+ * @Input : *InputPath, nSize
+ * @Output : *OutputPath
+ */
+void GetBatchOutputPath(const char* InputPath, char* OutputPath, int nSize)
+{
+	const char* pName = InputPath;
+
+	for (const char* p = InputPath; *p; p++)
+		if ('/' == *p || '\\' == *p)
+			pName = p + 1;
+
+	sprintf_s(OutputPath, nSize, "%s/%s", BATCH_OUTPUT_DIR, pName);
+
+	return;
+}
+
+/*
+ * @Function Name : GrowBatchBuffer
+ * @Descriotion : 슬롯 버퍼가 dwBytes보다 작으면 페이지 정렬로 다시 할당 (버퍼에 진행 중인 입출력이 없을 때만 호출)
+ * @Input : *pBuffer, *pdwCapacity, dwBytes
+ * @Output : *pBuffer, *pdwCapacity, 성공 1, 실패 0 (기존 버퍼 유지)
+ */
+int GrowBatchBuffer(BYTE** pBuffer, DWORD* pdwCapacity, DWORD dwBytes)
+{
+	BYTE* NewBuffer;
+
+	if (dwBytes <= *pdwCapacity)
+		return 1;
+
+	NewBuffer = (BYTE*)VirtualAlloc(NULL, dwBytes, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE);
+	if (NULL == NewBuffer)
+		return 0;
+
+	if (NULL != *pBuffer)
+		VirtualFree(*pBuffer, 0, MEM_RELEASE);
+	*pBuffer = NewBuffer;
+	*pdwCapacity = dwBytes;
+
+	return 1;
+}
+
+/*
+ * @Function Name : ProcessBatchFrame
+ * @Descriotion : 슬롯에 읽은 BMP 파일 전체에서 헤더/팔레트/화소를 찾아 연산하고, 출력 파일 내용 전체를 OutBuffer에 구성
+ *                출력 버퍼와 연산 임시 버퍼가 작으면 늘림 (연산과 같이 한 번에 하나씩 호출)
+ * @Input : *Job, *Slot (Buffer, dwFileSize)
+ * @Output : Slot->OutBuffer, 출력 바이트 수 (실패 시 0)
+ */
+DWORD ProcessBatchFrame(BATCH_JOB* Job, BATCH_SLOT* Slot)
+{
+	BITMAPFILEHEADER hf;
+	BITMAPINFOHEADER hInfo;
+	BYTE* FileData = Slot->Buffer;
+	BYTE* OutData;
+	DWORD dwFileSize = Slot->dwFileSize;
+	int nWidth, nHeight, nOutSize;
+
+	if (dwFileSize < 14 + 40)
+		return 0;
+
+	memcpy(&hf, FileData, 14);
+	memcpy(&hInfo, FileData + 14, 40);
+	nWidth = hInfo.biWidth;
+	nHeight = hInfo.biHeight;
+
+	if (8 != hInfo.biBitCount || nWidth < 1 || nHeight < 1 || hf.bfOffBits < 14 + 40 ||
+		(long long)hf.bfOffBits + (long long)nWidth * nHeight > dwFileSize ||
+		BATCH_HEADER_SIZE + (long long)((nWidth + 3) / 4 * 4) * nHeight > BATCH_MAX_FILE_SIZE)
+		return 0;
+
+	// 연산 결과는 입력보다 크지 않으므로 입력 크기(행 4바이트 정렬)로 버퍼 확보
+	if (0 == GrowBatchBuffer(&Slot->OutBuffer, &Slot->dwOutCapacity, BATCH_HEADER_SIZE + (DWORD)((nWidth + 3) / 4 * 4) * nHeight))
+		return 0;
+
+	if ((DWORD)nWidth * nHeight > Job->dwTempCapacity) {
+		BYTE* NewTemp = (BYTE*)malloc((size_t)nWidth * nHeight);
+
+		if (NULL == NewTemp)
+			return 0;
+		free(Job->Temp);
+		Job->Temp = NewTemp;
+		Job->dwTempCapacity = (DWORD)nWidth * nHeight;
+	}
+
+	OutData = Slot->OutBuffer;
+	if (0 == ApplyOperation(Job->nMode, Job->nParam, FileData + hf.bfOffBits, OutData + BATCH_HEADER_SIZE, Job->Temp, &nWidth, &nHeight))
+		return 0;
+
+	nOutSize = PadRows(OutData + BATCH_HEADER_SIZE, nWidth, nHeight);
+
+	// 출력 헤더 (팔레트는 입력 것을 사용, 없으면 회색조)
+	hInfo.biWidth = nWidth;
+	hInfo.biHeight = nHeight;
+	hInfo.biSizeImage = nOutSize;
+	hInfo.biClrUsed = 0;
+	if (hf.bfOffBits >= 14 + hInfo.biSize + 4 * 256)
+		memcpy(OutData + 14 + 40, FileData + 14 + hInfo.biSize, 4 * 256);
+	else
+		for (int i = 0; i < 256; i++) {
+			OutData[14 + 40 + 4 * i] = OutData[14 + 40 + 4 * i + 1] = OutData[14 + 40 + 4 * i + 2] = (BYTE)i;
+			OutData[14 + 40 + 4 * i + 3] = 0;
+		}
+	hInfo.biSize = 40;
+	hf.bfOffBits = BATCH_HEADER_SIZE;
+	hf.bfSize = BATCH_HEADER_SIZE + nOutSize;
+	memcpy(OutData, &hf, 14);
+	memcpy(OutData + 14, &hInfo, 40);
+
+	return hf.bfSize;
+}
+
+/*
+ * @Function Name : StartBatchRead
+ * @Descriotion : 다음 파일을 열어 파일 전체를 한 번에 비동기로 읽기 시작 (열기/시작에 실패한 파일은 건너뜀)
+ * @Input : *Job, *Slot
+ * @Output : 읽기 시작 1, 남은 파일 없음 0
+ */
+int StartBatchRead(BATCH_JOB* Job, BATCH_SLOT* Slot)
+{
+	while (Job->nNext < Job->nFiles) {
+		LARGE_INTEGER Size;
+		DWORD dwLength;
+
+		Slot->nFile = Job->nNext++;
+		Slot->hFile = CreateFileA(Job->Path[Slot->nFile], GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+			FILE_FLAG_OVERLAPPED | (Job->bDirect ? FILE_FLAG_NO_BUFFERING : 0), NULL);
+
+		if (INVALID_HANDLE_VALUE == Slot->hFile) {
+			InterlockedIncrement(&Job->lFailed);
+			continue;
+		}
+
+		if (!GetFileSizeEx(Slot->hFile, &Size) || Size.QuadPart > BATCH_MAX_FILE_SIZE ||
+			NULL == CreateIoCompletionPort(Slot->hFile, Job->hPort, 0, 0)) {
+			CloseHandle(Slot->hFile);
+			InterlockedIncrement(&Job->lFailed);
+			continue;
+		}
+
+		// NO_BUFFERING은 읽기 길이가 섹터 배수여야 함 (버퍼는 페이지 정렬)
+		Slot->dwFileSize = (DWORD)Size.QuadPart;
+		dwLength = Job->bDirect ? (Slot->dwFileSize + BATCH_SECTOR_SIZE - 1) / BATCH_SECTOR_SIZE * BATCH_SECTOR_SIZE : Slot->dwFileSize;
+
+		// 슬롯의 이전 입출력은 끝났으므로 큰 파일이면 버퍼를 늘림
+		if (0 == GrowBatchBuffer(&Slot->Buffer, &Slot->dwCapacity, dwLength)) {
+			CloseHandle(Slot->hFile);
+			InterlockedIncrement(&Job->lFailed);
+			continue;
+		}
+
+		memset(&Slot->Overlapped, 0, sizeof(OVERLAPPED));
+		Slot->nState = BATCH_READING;
+
+		if (!ReadFile(Slot->hFile, Slot->Buffer, dwLength, NULL, &Slot->Overlapped) && ERROR_IO_PENDING != GetLastError()) {
+			CloseHandle(Slot->hFile);
+			Slot->nState = BATCH_IDLE;
+			InterlockedIncrement(&Job->lFailed);
+			continue;
+		}
+
+		return 1;
+	}
+
+	Slot->nState = BATCH_IDLE;
+
+	return 0;
+}
+
+/*
+ * @Function Name : StartBatchWrite
+ * @Descriotion : 결과 파일을 만들어 OutBuffer 전체를 한 번에 비동기로 쓰기 시작
+ * @Input : *Job, *Slot, dwBytes
+ * @Output : 쓰기 시작 1, 실패 0
+ */
+int StartBatchWrite(BATCH_JOB* Job, BATCH_SLOT* Slot, DWORD dwBytes)
+{
+	char OutputPath[MAX_PATH];
+
+	GetBatchOutputPath(Job->Path[Slot->nFile], OutputPath, sizeof(OutputPath));
+
+	Slot->hFile = CreateFileA(OutputPath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_FLAG_OVERLAPPED, NULL);
+	if (INVALID_HANDLE_VALUE == Slot->hFile)
+		return 0;
+
+	if (NULL == CreateIoCompletionPort(Slot->hFile, Job->hPort, 0, 0)) {
+		CloseHandle(Slot->hFile);
+		return 0;
+	}
+
+	memset(&Slot->Overlapped, 0, sizeof(OVERLAPPED));
+	Slot->nState = BATCH_WRITING;
+
+	if (!WriteFile(Slot->hFile, Slot->OutBuffer, dwBytes, NULL, &Slot->Overlapped) && ERROR_IO_PENDING != GetLastError()) {
+		CloseHandle(Slot->hFile);
+		return 0;
+	}
+
+	return 1;
+}
+
+/*
+ * @Function Name : CancelBatchSlots
+ * @Descriotion : 완료 통지를 더 받을 수 없을 때 진행 중인 입출력을 취소하고 끝날 때까지 기다림 (슬롯 버퍼 해제 전)
+ *                취소한 파일과 아직 시작하지 않은 파일은 실패로 셈
+ * @Input : *Job
+ * @Output : Job 통계
+ */
+void CancelBatchSlots(BATCH_JOB* Job)
+{
+	for (int i = 0; i < BATCH_MAX_INFLIGHT; i++) {
+		BATCH_SLOT* Slot = &Job->Slot[i];
+		DWORD dwBytes = 0;
+
+		if (BATCH_IDLE == Slot->nState)
+			continue;
+
+		CancelIoEx(Slot->hFile, &Slot->Overlapped);
+		GetOverlappedResult(Slot->hFile, &Slot->Overlapped, &dwBytes, TRUE);
+		CloseHandle(Slot->hFile);
+		Slot->nState = BATCH_IDLE;
+		InterlockedIncrement(&Job->lFailed);
+	}
+
+	InterlockedExchangeAdd(&Job->lFailed, Job->nFiles - Job->nNext);
+	Job->nNext = Job->nFiles;
+
+	return;
+}
+
+/*
+ * @Function Name : RunBatchCompletionPort
+ * @Descriotion : 모든 슬롯의 읽기를 먼저 제출한 뒤, 완료 통지를 한 번에 여러 개씩 받아
+ *                읽기 완료 -> 연산 -> 쓰기 제출, 쓰기 완료 -> 다음 파일 읽기 제출을 반복
+ * @Input : *Job
+ * @Output : Job 통계
+ */
+void RunBatchCompletionPort(BATCH_JOB* Job)
+{
+	OVERLAPPED_ENTRY Entry[BATCH_MAX_INFLIGHT];
+	int nActive = 0;
+
+	for (int i = 0; i < BATCH_MAX_INFLIGHT; i++)
+		nActive += StartBatchRead(Job, &Job->Slot[i]);
+
+	while (nActive > 0) {
+		ULONG nRemoved = 0;
+
+		if (!GetQueuedCompletionStatusEx(Job->hPort, Entry, BATCH_MAX_INFLIGHT, &nRemoved, INFINITE, FALSE)) {
+			CancelBatchSlots(Job);
+			break;
+		}
+
+		for (ULONG e = 0; e < nRemoved; e++) {
+			BATCH_SLOT* Slot = (BATCH_SLOT*)Entry[e].lpOverlapped;
+			DWORD dwBytes = 0;
+			BOOL bOk = GetOverlappedResult(Slot->hFile, &Slot->Overlapped, &dwBytes, FALSE);
+
+			CloseHandle(Slot->hFile);
+
+			if (BATCH_READING == Slot->nState) {
+				DWORD dwOutBytes = 0;
+
+				// 다른 슬롯의 입출력이 진행되는 동안 연산
+				if (bOk && dwBytes >= Slot->dwFileSize) {
+					InterlockedExchangeAdd64(&Job->llBytesRead, Slot->dwFileSize);
+					dwOutBytes = ProcessBatchFrame(Job, Slot);
+				}
+
+				if (dwOutBytes > 0 && StartBatchWrite(Job, Slot, dwOutBytes))
+					continue;
+
+				InterlockedIncrement(&Job->lFailed);
+			}
+			else {
+				if (bOk) {
+					InterlockedExchangeAdd64(&Job->llBytesWritten, dwBytes);
+					InterlockedIncrement(&Job->lDone);
+				}
+				else
+					InterlockedIncrement(&Job->lFailed);
+			}
+
+			if (0 == StartBatchRead(Job, Slot))
+				nActive--;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : BatchSyncBand
+ * @Descriotion : RunBands용 (Completion Port 대체 경로) - 목록 [nStartRow, nEndRow)의 파일을 동기 입출력으로 처리
+ *                입출력은 띠마다 자기 슬롯 버퍼로 겹쳐 진행하고, 연산은 Job->Lock으로 한 번에 하나씩 (연산 자체는 RunBands로 전체 코어 사용)
+ * @Input : pParam(BATCH_JOB), nBand, nStartRow, nEndRow
+ * @Output : Job 통계
+ */
+void BatchSyncBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	BATCH_JOB* Job = (BATCH_JOB*)pParam;
+	BATCH_SLOT* Slot = &Job->Slot[nBand];
+	char OutputPath[MAX_PATH];
+
+	for (int f = nStartRow; f < nEndRow; f++) {
+		FILE* fp = NULL;
+		DWORD dwOutBytes = 0;
+
+		long lSize = -1;
+
+		fopen_s(&fp, Job->Path[f], "rb");
+		if (NULL != fp && 0 == fseek(fp, 0, SEEK_END)) {
+			lSize = ftell(fp);
+			rewind(fp);
+		}
+
+		// 큰 파일이면 이 띠의 슬롯 버퍼를 늘림
+		if (NULL == fp || lSize < 0 || lSize > BATCH_MAX_FILE_SIZE || 0 == GrowBatchBuffer(&Slot->Buffer, &Slot->dwCapacity, (DWORD)lSize)) {
+			if (NULL != fp)
+				fclose(fp);
+			InterlockedIncrement(&Job->lFailed);
+			continue;
+		}
+
+		// 헤더 + 팔레트 + 화소를 한 번에 읽음
+		Slot->dwFileSize = (DWORD)fread(Slot->Buffer, 1, (size_t)lSize, fp);
+		fclose(fp);
+		InterlockedExchangeAdd64(&Job->llBytesRead, Slot->dwFileSize);
+
+		EnterCriticalSection(&Job->Lock);
+		dwOutBytes = ProcessBatchFrame(Job, Slot);
+		LeaveCriticalSection(&Job->Lock);
+
+		GetBatchOutputPath(Job->Path[f], OutputPath, sizeof(OutputPath));
+		fp = NULL;
+		if (dwOutBytes > 0)
+			fopen_s(&fp, OutputPath, "wb");
+
+		if (NULL == fp || dwOutBytes != fwrite(Slot->OutBuffer, 1, dwOutBytes, fp)) {
+			if (NULL != fp)
+				fclose(fp);
+			InterlockedIncrement(&Job->lFailed);
+			continue;
+		}
+
+		fclose(fp);
+		InterlockedExchangeAdd64(&Job->llBytesWritten, dwOutBytes);
+		InterlockedIncrement(&Job->lDone);
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : RunBatch
+ * @Descriotion : 목록 파일의 모든 이미지에 연산 하나를 적용하여 BATCH_OUTPUT_DIR에 같은 이름으로 저장
+ * @Input : *ListPath, nMode, nParam, bDirect
+ * @Output : 성공 1, 실패 0
+ */
+int RunBatch(const char* ListPath, int nMode, int nParam, int bDirect)
+{
+	BATCH_JOB* Job;
+	LARGE_INTEGER Start, End;
+	int nResult = 1, bPort = 0;
+	double dElapsed;
+
+	Job = (BATCH_JOB*)calloc(1, sizeof(BATCH_JOB));
+	if (NULL == Job)
+		return 0;
+
+	Job->nMode = nMode;
+	Job->nParam = nParam;
+	Job->bDirect = bDirect;
+	Job->Path = LoadBatchList(ListPath, &Job->nFiles);
+
+	if (NULL == Job->Path || (!CreateDirectoryA(BATCH_OUTPUT_DIR, NULL) && ERROR_ALREADY_EXISTS != GetLastError())) {
+		free(Job->Path);
+		free(Job);
+		return 0;
+	}
+
+	// 슬롯 버퍼 (페이지 정렬, 파일마다 할당하지 않고 더 큰 파일이 올 때만 늘림)
+	for (int i = 0; i < BATCH_MAX_INFLIGHT && nResult; i++) {
+		nResult = GrowBatchBuffer(&Job->Slot[i].Buffer, &Job->Slot[i].dwCapacity, BATCH_FRAME_SIZE) &&
+			GrowBatchBuffer(&Job->Slot[i].OutBuffer, &Job->Slot[i].dwOutCapacity, BATCH_FRAME_SIZE);
+	}
+	Job->Temp = (BYTE*)malloc(BATCH_FRAME_SIZE);
+	Job->dwTempCapacity = BATCH_FRAME_SIZE;
+	Job->hPort = CreateIoCompletionPort(INVALID_HANDLE_VALUE, NULL, 0, 1);
+
+	nResult = nResult && NULL != Job->Temp;
+	bPort = nResult && NULL != Job->hPort;
+	InitializeCriticalSection(&Job->Lock);
+
+	QueryPerformanceCounter(&Start);
+
+	if (bPort)
+		RunBatchCompletionPort(Job);
+	else if (nResult)
+		RunBands(BatchSyncBand, Job, Job->nFiles, GetBandCount(Job->nFiles, 1) < BATCH_MAX_INFLIGHT ? GetBandCount(Job->nFiles, 1) : BATCH_MAX_INFLIGHT);
+
+	QueryPerformanceCounter(&End);
+	dElapsed = GetElapsedTime(Start, End);
+
+	if (nResult)
+		printf("Batch : %ld done, %ld failed, %.3f sec (%.1f files/sec), read %lld bytes, written %lld bytes (%s)\n",
+			(long)Job->lDone, (long)Job->lFailed, dElapsed, dElapsed > 0.0 ? Job->lDone / dElapsed : 0.0,
+			(long long)Job->llBytesRead, (long long)Job->llBytesWritten, bPort ? "completion port" : "threads");
+
+	DeleteCriticalSection(&Job->Lock);
+	if (NULL != Job->hPort)
+		CloseHandle(Job->hPort);
+	for (int i = 0; i < BATCH_MAX_INFLIGHT; i++) {
+		if (NULL != Job->Slot[i].Buffer)
+			VirtualFree(Job->Slot[i].Buffer, 0, MEM_RELEASE);
+		if (NULL != Job->Slot[i].OutBuffer)
+			VirtualFree(Job->Slot[i].OutBuffer, 0, MEM_RELEASE);
+	}
+	free(Job->Temp);
+	free(Job->Path);
+	free(Job);
+
+	return nResult;
+}
+
+/*
+ * ver 2.4 : Euclidean Distance Transform (Felzenszwalb-Huttenlocher) + 원판(Disk) Morphology
+ * 이진 영상에서 각 픽셀과 가장 가까운 대상(feature) 픽셀 사이의 정확한 유클리드 거리를 O(픽셀 수)로 계산
+ * 1. 열 방향 (열 띠 병렬) : 위 -> 아래, 아래 -> 위 두 번 훑어 같은 열의 가장 가까운 대상까지 거리 (행 우선 순서로 접근)
+ * 2. 행 방향 (행 띠 병렬) : 포물선 (x - q)^2 + f(q)의 하한 포락선(lower envelope)으로 제곱 거리
+ * 임의 반경의 원판 팽창/침식은 제곱 거리를 r^2과 비교하는 것으로 픽셀당 상수 시간 (행 방향 단계에서 바로 출력)
+ */
+
+#define EDT_INF				0x7FFFFFFF	// 대상 픽셀이 없음
+#define EDT_MIN_COLUMNS		64			// 열 띠 하나의 최소 열 수
+
+// 출력 형식
+#define EDT_SQUARED			0			// int 제곱 거리 (대상 없음 EDT_INF)
+#define EDT_WORD			1			// WORD 거리 (반올림, 대상 없음 65535)
+#define EDT_FLOAT			2			// float 거리 (대상 없음 HUGE_VAL)
+#define EDT_THRESHOLD		3			// BYTE : 제곱 거리 <= nSqRadius 이면 bNear, 아니면 bFar
+
+typedef struct {
+	BYTE* Input;
+	int* Column;			// 열 방향 단계 결과 (제곱 거리)
+	void* Output;
+	int nWidth, nHeight;
+	int nTarget;			// 1 : 0이 아닌 픽셀까지 거리, 0 : 0인 픽셀까지 거리
+	int nOutput;			// EDT_SQUARED, EDT_WORD, EDT_FLOAT, EDT_THRESHOLD
+	int nSqRadius;
+	BYTE bNear, bFar;
+	int nError;
+} EDT_PARAM;
+
+/*
+ * @Function Name : EDTColumnBand
+ * @Descriotion : RunBands용 (열 띠) - 열마다 가장 가까운 대상 픽셀까지의 세로 거리를 구해 제곱하여 저장
+ *                열 하나씩이 아니라 띠의 열들을 한 행씩 함께 진행하여 행 우선 메모리 순서로 접근
+ * @Input : pParam(EDT_PARAM), nBand, nStartCol, nEndCol
+ * @Output : EDT_PARAM->Column
+ */
+void EDTColumnBand(void* pParam, int nBand, int nStartCol, int nEndCol)
+{
+	EDT_PARAM* p = (EDT_PARAM*)pParam;
+	int nWidth = p->nWidth;
+
+	// 위 -> 아래 : 위쪽에서 가장 가까운 대상까지 거리
+	for (int y = 0; y < p->nHeight; y++) {
+		BYTE* pIn = &p->Input[y * nWidth];
+		int* pCol = &p->Column[y * nWidth];
+		int* pAbove = &p->Column[(y > 0 ? y - 1 : 0) * nWidth];
+
+		for (int x = nStartCol; x < nEndCol; x++) {
+			if ((0 != pIn[x]) == p->nTarget)
+				pCol[x] = 0;
+			else if (0 == y || EDT_INF == pAbove[x])
+				pCol[x] = EDT_INF;
+			else
+				pCol[x] = pAbove[x] + 1;
+		}
+	}
+
+	// 아래 -> 위 : 아래쪽 대상과 비교, 비교가 끝난 아래 행은 제곱
+	for (int y = p->nHeight - 2; y >= 0; y--) {
+		int* pCol = &p->Column[y * nWidth];
+		int* pBelow = pCol + nWidth;
+
+		for (int x = nStartCol; x < nEndCol; x++) {
+			if (EDT_INF != pBelow[x] && pBelow[x] + 1 < pCol[x])
+				pCol[x] = pBelow[x] + 1;
+
+			if (EDT_INF != pBelow[x])
+				pBelow[x] *= pBelow[x];
+		}
+	}
+
+	for (int x = nStartCol; x < nEndCol; x++)
+		if (EDT_INF != p->Column[x])
+			p->Column[x] *= p->Column[x];
+
+	return;
+}
+
+/*
+ * @Function Name : EDTRowBand
+ * @Descriotion : RunBands용 (행 띠) - 행마다 열 방향 제곱 거리 f(q)에 대해 포물선 (x - q)^2 + f(q)의 하한 포락선을 구성하고
+ *                각 x에서 최소값(제곱 거리)을 nOutput 형식으로 출력
+ * @Input : pParam(EDT_PARAM), nBand, nStartRow, nEndRow
+ * @Output : EDT_PARAM->Output
+ */
+void EDTRowBand(void* pParam, int nBand, int nStartRow, int nEndRow)
+{
+	EDT_PARAM* p = (EDT_PARAM*)pParam;
+	int nWidth = p->nWidth;
+	int* f = (int*)malloc(sizeof(int) * nWidth);			// 행의 열 방향 제곱 거리
+	int* v = (int*)malloc(sizeof(int) * nWidth);			// 포락선을 이루는 포물선의 꼭지점 위치
+	double* z = (double*)malloc(sizeof(double) * (nWidth + 1));	// 포물선 k가 최소가 되는 구간 [z[k], z[k+1]]
+
+	if (NULL == f || NULL == v || NULL == z) {
+		free(f);
+		free(v);
+		free(z);
+		p->nError = 1;
+		return;
+	}
+
+	for (int y = nStartRow; y < nEndRow; y++) {
+		int k = -1;
+
+		memcpy(f, &p->Column[y * nWidth], sizeof(int) * nWidth);
+
+		// 하한 포락선 구성 (대상이 없는 열은 포물선 없음)
+		for (int q = 0; q < nWidth; q++) {
+			double s;
+
+			if (EDT_INF == f[q])
+				continue;
+
+			if (k < 0) {
+				k = 0;
+				v[0] = q;
+				z[0] = -HUGE_VAL;
+				z[1] = HUGE_VAL;
+				continue;
+			}
+
+			// 포물선 q와 v[k]의 교점, 교점이 z[k] 이하이면 v[k]는 포락선에서 제외
+			while (1) {
+				s = ((f[q] + (double)q * q) - (f[v[k]] + (double)v[k] * v[k])) / (2.0 * (q - v[k]));
+				if (s > z[k])
+					break;
+				k--;
+			}
+
+			k++;
+			v[k] = q;
+			z[k] = s;
+			z[k + 1] = HUGE_VAL;
+		}
+
+		// 포락선 값을 읽으면서 바로 출력 형식으로 변환
+		for (int x = 0, j = 0; x < nWidth; x++) {
+			int nSq = EDT_INF;
+
+			if (k >= 0) {
+				while (z[j + 1] < x)
+					j++;
+				nSq = (x - v[j]) * (x - v[j]) + f[v[j]];
+			}
+
+			switch (p->nOutput) {
+			case EDT_WORD:
+				if (EDT_INF == nSq)
+					((WORD*)p->Output)[y * nWidth + x] = 65535;
+				else
+					((WORD*)p->Output)[y * nWidth + x] = (WORD)(sqrt((double)nSq) + 0.5);
+				break;
+			case EDT_FLOAT:
+				((float*)p->Output)[y * nWidth + x] = (EDT_INF == nSq) ? (float)HUGE_VAL : (float)sqrt((double)nSq);
+				break;
+			case EDT_THRESHOLD:
+				((BYTE*)p->Output)[y * nWidth + x] = (nSq <= p->nSqRadius) ? p->bNear : p->bFar;
+				break;
+			default:
+				((int*)p->Output)[y * nWidth + x] = nSq;
+				break;
+			}
+		}
+	}
+
+	free(f);
+	free(v);
+	free(z);
+
+	return;
+}
+
+/*
+ * @Function Name : RunDistanceTransform
+ * @Descriotion : 열 방향 단계(열 띠 병렬) 후 행 방향 단계(행 띠 병렬)를 수행
+ *                EDT_SQUARED 출력은 열 방향 결과 버퍼로 그대로 사용 (행 단계는 행을 복사한 뒤 덮어씀)
+ * @Input : *Param (Input, Output, nWidth, nHeight, nTarget, nOutput, nSqRadius, bNear, bFar)
+ * @Output : Param->Output, 성공 1, 메모리 할당 실패 0
+ */
+int RunDistanceTransform(EDT_PARAM* Param)
+{
+	PROFILE_BEGIN();
+
+	int nImgSize = Param->nWidth * Param->nHeight;
+
+	Param->nError = 0;
+
+	if (Param->nWidth < 1 || Param->nHeight < 1)
+		goto CLEANUP;
+
+	if (EDT_SQUARED == Param->nOutput)
+		Param->Column = (int*)Param->Output;
+	else
+		Param->Column = (int*)malloc(sizeof(int) * nImgSize);
+	if (NULL == Param->Column) {
+		Param->nError = 1;
+		goto CLEANUP;
+	}
+
+	RunBands(EDTColumnBand, Param, Param->nWidth, GetBandCount(Param->nWidth, EDT_MIN_COLUMNS));
+	RunBands(EDTRowBand, Param, Param->nHeight, GetBandCount(Param->nHeight, 16));
+
+	if (EDT_SQUARED != Param->nOutput)
+		free(Param->Column);
+
+CLEANUP:
+	PROFILE_END(nImgSize, nImgSize + 2 * sizeof(int) * nImgSize, sizeof(int) * nImgSize + nImgSize);
+
+	return 0 == Param->nError;
+}
+
+/*
+ * @Function Name : EuclideanDistanceTransform
+ * @Descriotion : 각 픽셀에서 가장 가까운 대상 픽셀까지의 정확한 유클리드 거리
+ *                bToForeground = 0 : 0인 픽셀(배경)까지 거리 (GenerateBinarization 결과의 전경 내부 거리 = 가장자리까지 거리)
+ *                bToForeground = 1 : 0이 아닌 픽셀(전경)까지 거리
+ * @Input : *Input, nWidth, nHeight, bToForeground, nOutput(EDT_SQUARED, EDT_WORD, EDT_FLOAT)
+ * @Output : *Output (int / WORD / float x nWidth x nHeight), 성공 1, 메모리 할당 실패 0
+ */
+int EuclideanDistanceTransform(BYTE* Input, void* Output, int nWidth, int nHeight, int bToForeground, int nOutput)
+{
+	EDT_PARAM Param;
+
+	if (nOutput < EDT_SQUARED || nOutput > EDT_FLOAT)
+		return 0;
+
+	Param.Input = Input;
+	Param.Output = Output;
+	Param.nWidth = nWidth;
+	Param.nHeight = nHeight;
+	Param.nTarget = (0 != bToForeground);
+	Param.nOutput = nOutput;
+	Param.nSqRadius = 0;
+	Param.bNear = Param.bFar = 0;
+
+	return RunDistanceTransform(&Param);
+}
+
+/*
+ * @Function Name : DiskMorphology
+ * @Descriotion : 반경 nRadius 원판(dx^2 + dy^2 <= r^2) 구조 요소로 이진 영상(0이 아니면 전경)을 팽창 / 침식
+ *                팽창 : 전경까지 제곱 거리 <= r^2 이면 255, 침식 : 배경까지 제곱 거리 > r^2 이면 255 (영상 밖은 고려하지 않음)
+ *                반경과 무관하게 픽셀당 상수 시간
+ * @Input : *Input, nWidth, nHeight, nRadius, bDilate(1 팽창, 0 침식)
+ * @Output : *Output (0 / 255), 성공 1, 실패 0
+ */
+int DiskMorphology(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nRadius, int bDilate)
+{
+	EDT_PARAM Param;
+
+	if (nRadius < 0 || nRadius > 32767)
+		return 0;
+
+	Param.Input = Input;
+	Param.Output = Output;
+	Param.nWidth = nWidth;
+	Param.nHeight = nHeight;
+	Param.nTarget = (0 != bDilate);
+	Param.nOutput = EDT_THRESHOLD;
+	Param.nSqRadius = nRadius * nRadius;
+	Param.bNear = bDilate ? 255 : 0;
+	Param.bFar = bDilate ? 0 : 255;
+
+	return RunDistanceTransform(&Param);
+}
+
+/*
+ * ver 2.3 : 최적화 변형 차등(Differential) 검증 / Fuzz
+ * 기존 Scalar 함수를 기준(reference)으로 두고 SIMD / 다중 스레드 / FFT / 통계 재사용 / 단계 융합 변형을 무작위 입력에서 비교
+ * 크기 : 홀수 폭, 폭 또는 높이 1 ~ 3 픽셀, 패턴 : 무작위, 0, 255, 체크무늬, 0/255 잡음, 128 근처
+ * 입력/출력 버퍼 시작 주소를 무작위로 어긋나게 하고, 출력 뒤 보호 영역과 입력 변경 여부로 범위 밖 쓰기를 검사
+ * 같은 실행에서 VERIFY_BENCH_WIDTH x VERIFY_BENCH_HEIGHT 영상으로 변형별 속도 향상을 측정
+ * 새 변형은 VERIFY_FUNC 형태의 함수 쌍을 g_VerifyCase에 추가
+ */
+
+#define VERIFY_MAX_WIDTH	512
+#define VERIFY_MAX_HEIGHT	256
+#define VERIFY_MAX_ALIGN	16			// 버퍼 시작 주소를 어긋나게 할 최대 바이트
+#define VERIFY_GUARD		64			// 출력 뒤 보호 영역 바이트
+#define VERIFY_FILL			0xA5		// 출력 버퍼 초기값 (두 함수가 쓰지 않는 영역은 같은 값으로 남음)
+#define VERIFY_MIN_OUTPUT	1024		// 히스토그램(int 256개) 출력에 필요한 최소 크기
+#define VERIFY_MAX_KSIZE	31
+#define VERIFY_BENCH_WIDTH	1024
+#define VERIFY_BENCH_HEIGHT	1024
+#define VERIFY_BENCH_RUNS	3			// 속도 측정 반복 (최소 시간 사용)
+#define VERIFY_MAX_REPORTS	3			// 변형별로 출력할 불일치 시행 수
+
+// 검증 대상 함수 : 출력 바이트 수 반환 (수행할 수 없으면 0)
+typedef int (*VERIFY_FUNC)(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam);
+
+typedef struct {
+	const char* Name;
+	VERIFY_FUNC Reference;		// 기준 Scalar 함수
+	VERIFY_FUNC Variant;		// 최적화 변형
+	int nTolerance;				// 픽셀당 허용 오차 (0이면 정확히 일치)
+	int nBenchParam;			// 속도 측정에 사용할 인자
+} VERIFY_CASE;
+
+typedef struct {
+	int nTrials;
+	int nMismatches;			// 허용 오차를 넘은 시행 수
+	int nFailures;				// 변형 실패, 보호 영역/입력 변경 시행 수
+	int nMaxDiff;
+	int nReports;
+	double dRefTime;			// 속도 측정 시간(초)
+	double dVarTime;
+} VERIFY_RESULT;
+
+/*
+ * @Function Name : VerifyAverage
+ * @Descriotion : 기준 - AverageConvolution
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyAverage(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	AverageConvolution(Input, Output, nWidth, nHeight);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyAverageKernel
+ * @Descriotion : 변형 - AvgKernel을 KernelConvolution으로 적용
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyAverageKernel(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	double Kernel[9];
+
+	for (int i = 0; i < 9; i++)
+		Kernel[i] = AvgKernel[i / 3][i % 3];
+
+	KernelConvolution(Input, Output, nWidth, nHeight, Kernel, 3);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyGaussian
+ * @Descriotion : 기준 - GaussianConvolution
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyGaussian(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	GaussianConvolution(Input, Output, nWidth, nHeight);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyGaussianKernel
+ * @Descriotion : 변형 - GaussKernel을 KernelConvolution으로 적용
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyGaussianKernel(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	double Kernel[9];
+
+	for (int i = 0; i < 9; i++)
+		Kernel[i] = GaussKernel[i / 3][i % 3];
+
+	KernelConvolution(Input, Output, nWidth, nHeight, Kernel, 3);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : GetVerifyKernel
+ * @Descriotion : nParam으로 Kernel 크기(5 ~ VERIFY_MAX_KSIZE)와 종류를 결정
+ *                짝수 nParam은 Gaussian, 홀수는 2 x 중심 - Gaussian (음수 가중치, 0 ~ 255 조정 경로 검사)
+ * @Input : nParam
+ * @Output : *Kernel, Kernel 크기
+ */
+int GetVerifyKernel(double* Kernel, int nParam)
+{
+	int nKSize = 5 + 2 * (nParam % ((VERIFY_MAX_KSIZE - 5) / 2 + 1));
+
+	GenerateGaussianKernel(Kernel, nKSize);
+
+	if (nParam & 1) {
+		for (int i = 0; i < nKSize * nKSize; i++)
+			Kernel[i] = -Kernel[i];
+		Kernel[nKSize * nKSize / 2] += 2.0;
+	}
+
+	return nKSize;
+}
+
+/*
+ * @Function Name : VerifyDirectConvolution
+ * @Descriotion : 기준 - DirectConvolution
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyDirectConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	double Kernel[VERIFY_MAX_KSIZE * VERIFY_MAX_KSIZE];
+	int nKSize = GetVerifyKernel(Kernel, nParam);
+
+	DirectConvolution(Input, Output, nWidth, nHeight, Kernel, nKSize);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyFFTConvolution
+ * @Descriotion : 변형 - FFTConvolution (Overlap-add)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyFFTConvolution(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	double Kernel[VERIFY_MAX_KSIZE * VERIFY_MAX_KSIZE];
+	int nKSize = GetVerifyKernel(Kernel, nParam);
+
+	if (0 == FFTConvolution(Input, Output, nWidth, nHeight, Kernel, nKSize))
+		return 0;
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyBinarization
+ * @Descriotion : 기준 - GenerateBinarization (임계값 nParam % 256)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	GenerateBinarization(Input, Output, nWidth, nHeight, (BYTE)(nParam % 256));
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyPackedBinarization
+ * @Descriotion : 변형 - GeneratePackedBinarization (SSE2) 결과를 8비트 0 / 255로 풀어서 출력
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyPackedBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nStride = GetPackedStride(nWidth);
+	BYTE* Packed = (BYTE*)malloc((SIZE_T)nStride * nHeight);
+
+	if (NULL == Packed)
+		return 0;
+
+	GeneratePackedBinarization(Input, Packed, nWidth, nHeight, (BYTE)(nParam % 256));
+
+	for (int i = 0; i < nHeight; i++)
+		for (int j = 0; j < nWidth; j++)
+			Output[i * nWidth + j] = (Packed[i * nStride + (j >> 3)] & (0x80 >> (j & 7))) ? 255 : 0;
+
+	free(Packed);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyRLEBinarization
+ * @Descriotion : 변형 - GenerateRLEBinarization 스트림을 복호화하여 출력
+ *                행 끝(0, 0) / Bitmap 끝(0, 1) 위치가 맞지 않으면 실패
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyRLEBinarization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	// 최악의 경우 : 픽셀마다 Run 1개 + 행마다 끝 표시
+	int nCapacity = 2 * nWidth * nHeight + 2 * nHeight;
+	BYTE* Stream = (BYTE*)malloc(nCapacity);
+	int nSize, nPos = 0, nResult = 0;
+
+	if (NULL == Stream)
+		return 0;
+
+	nSize = GenerateRLEBinarization(Input, Stream, nWidth, nHeight, (BYTE)(nParam % 256), nCapacity);
+
+	for (int i = 0; i < nHeight; i++) {
+		int j = 0;
+
+		while (nPos + 2 <= nSize && 0 != Stream[nPos]) {
+			if (j + Stream[nPos] > nWidth)
+				goto CLEANUP;
+
+			memset(&Output[i * nWidth + j], Stream[nPos + 1], Stream[nPos]);
+			j += Stream[nPos];
+			nPos += 2;
+		}
+
+		if (j != nWidth || nPos + 2 > nSize || Stream[nPos + 1] != ((i == nHeight - 1) ? 1 : 0))
+			goto CLEANUP;
+		nPos += 2;
+	}
+
+	if (nPos == nSize)
+		nResult = nWidth * nHeight;
+
+CLEANUP:
+	free(Stream);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : GetVerifyPooling
+ * @Descriotion : nParam으로 Pooling 창 크기(2, 3)와 종류를 결정
+ * @Input : nParam
+ * @Output : *pK, *pType
+ */
+void GetVerifyPooling(int nParam, int* pK, int* pType)
+{
+	*pK = 2 + nParam % 2;
+	*pType = POOL_MIN + (nParam / 2) % 4;
+
+	return;
+}
+
+/*
+ * @Function Name : VerifyPoolWindow
+ * @Descriotion : 기준 - 출력 픽셀마다 PoolWindow (MinPooling / MaxPooling / MedianPooling / 평균)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyPoolWindow(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nK, nType;
+
+	GetVerifyPooling(nParam, &nK, &nType);
+
+	for (int y = 0; y < nHeight / nK; y++)
+		for (int x = 0; x < nWidth / nK; x++)
+			Output[y * (nWidth / nK) + x] = PoolWindow(Input, nWidth, x * nK, y * nK, nK, nType);
+
+	return (nWidth / nK) * (nHeight / nK);
+}
+
+/*
+ * @Function Name : VerifyStridedPooling
+ * @Descriotion : 변형 - StridedPooling (SSE2 행 처리)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyStridedPooling(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nK, nType;
+
+	GetVerifyPooling(nParam, &nK, &nType);
+
+	if (0 == StridedPooling(Input, Output, nWidth, nHeight, nK, nType))
+		return 0;
+
+	return (nWidth / nK) * (nHeight / nK);
+}
+
+/*
+ * @Function Name : VerifyHistogram
+ * @Descriotion : 기준 - GenerateHistogram (int 256개를 출력 버퍼에 복사)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyHistogram(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nHisto[256] = { 0, };
+
+	GenerateHistogram(Input, nHisto, nWidth, nHeight);
+	memcpy(Output, nHisto, sizeof(nHisto));
+
+	return sizeof(nHisto);
+}
+
+/*
+ * @Function Name : VerifyStatsHistogram
+ * @Descriotion : 변형 - GetImageStats (행 띠 병렬 히스토그램)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyStatsHistogram(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	IMAGE_STATS Stats;
+
+	Stats.Image = NULL;
+	GetImageStats(&Stats, Input, nWidth, nHeight);
+	memcpy(Output, Stats.nHisto, sizeof(Stats.nHisto));
+
+	return sizeof(Stats.nHisto);
+}
+
+/*
+ * @Function Name : VerifyGonzalez
+ * @Descriotion : 기준 - GenerateHistogram + GonzalezMethod 임계값으로 이진화
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyGonzalez(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nHisto[256] = { 0, };
+
+	GenerateHistogram(Input, nHisto, nWidth, nHeight);
+	GenerateBinarization(Input, Output, nWidth, nHeight, GonzalezMethod(nHisto));
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyStatsGonzalez
+ * @Descriotion : 변형 - GetImageStats의 최소/최대로 GonzalezMethodRange
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyStatsGonzalez(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	IMAGE_STATS Stats;
+
+	Stats.Image = NULL;
+	GetImageStats(&Stats, Input, nWidth, nHeight);
+	GenerateBinarization(Input, Output, nWidth, nHeight, GonzalezMethodRange(Stats.nHisto, Stats.bMin, Stats.bMax));
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyStretching
+ * @Descriotion : 기준 - GenerateHistogram + HistogramStretching
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyStretching(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nHisto[256] = { 0, };
+
+	GenerateHistogram(Input, nHisto, nWidth, nHeight);
+	HistogramStretching(Input, Output, nHisto, nWidth, nHeight);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyStatsStretching
+ * @Descriotion : 변형 - GetImageStats의 최소/최대로 HistogramStretchingRange
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyStatsStretching(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	IMAGE_STATS Stats;
+
+	Stats.Image = NULL;
+	GetImageStats(&Stats, Input, nWidth, nHeight);
+	HistogramStretchingRange(Input, Output, Stats.bMin, Stats.bMax, nWidth, nHeight);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyEqualization
+ * @Descriotion : 기준 - GenerateHistogram + HistogramEqualization
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyEqualization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nHisto[256] = { 0, };
+
+	GenerateHistogram(Input, nHisto, nWidth, nHeight);
+	HistogramEqualization(Input, Output, nHisto, nWidth, nHeight);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyStatsEqualization
+ * @Descriotion : 변형 - GetImageStats 히스토그램으로 HistogramEqualization
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyStatsEqualization(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	IMAGE_STATS Stats;
+
+	Stats.Image = NULL;
+	GetImageStats(&Stats, Input, nWidth, nHeight);
+	HistogramEqualization(Input, Output, Stats.nHisto, nWidth, nHeight);
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyDiskBruteForce
+ * @Descriotion : 기준 - 원판 안의 모든 이웃을 직접 검사하는 팽창 / 침식 (반경 nParam % 8, 팽창 여부 (nParam / 8) % 2)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyDiskBruteForce(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int r = nParam % 8;
+	int bDilate = (nParam / 8) % 2;
+
+	for (int y = 0; y < nHeight; y++) {
+		for (int x = 0; x < nWidth; x++) {
+			// 팽창 : 원판 안에 전경이 하나라도 있으면 255, 침식 : 원판 안에 배경이 하나라도 있으면 0
+			int bFound = 0;
+
+			for (int m = -r; m <= r && 0 == bFound; m++) {
+				for (int n = -r; n <= r; n++) {
+					if (m * m + n * n > r * r || y + m < 0 || y + m >= nHeight || x + n < 0 || x + n >= nWidth)
+						continue;
+
+					if ((0 != Input[(y + m) * nWidth + (x + n)]) == bDilate) {
+						bFound = 1;
+						break;
+					}
+				}
+			}
+
+			Output[y * nWidth + x] = (bFound == bDilate) ? 255 : 0;
+		}
+	}
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyDiskMorphology
+ * @Descriotion : 변형 - DiskMorphology (거리 변환 임계값)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyDiskMorphology(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	if (0 == DiskMorphology(Input, Output, nWidth, nHeight, nParam % 8, (nParam / 8) % 2))
+		return 0;
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : GetVerifyBilateral
+ * @Descriotion : nParam으로 정확 Bilateral Filter의 반경(1 ~ BILATERAL_EXACT_MAX_RADIUS)과 밝기 sigma(10 ~ 80) 결정
+ * @Input : nParam
+ * @Output : *pRadius, *pSigmaRange
+ */
+void GetVerifyBilateral(int nParam, int* pRadius, double* pSigmaRange)
+{
+	*pRadius = 1 + nParam % BILATERAL_EXACT_MAX_RADIUS;
+	*pSigmaRange = 10.0 * (1 + (nParam / 8) % 8);
+
+	return;
+}
+
+/*
+ * @Function Name : VerifyBilateralScalar
+ * @Descriotion : 기준 - BilateralFilterExact (Scalar)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyBilateralScalar(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nRadius;
+	double dSigmaRange;
+
+	GetVerifyBilateral(nParam, &nRadius, &dSigmaRange);
+
+	if (0 == BilateralFilterExact(Input, Output, nWidth, nHeight, nRadius, nRadius / 2.0, dSigmaRange, 1))
+		return 0;
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : VerifyBilateralSSE
+ * @Descriotion : 변형 - BilateralFilterExact (4화소 SSE2 + Scalar 꼬리)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyBilateralSSE(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nRadius;
+	double dSigmaRange;
+
+	GetVerifyBilateral(nParam, &nRadius, &dSigmaRange);
+
+	if (0 == BilateralFilterExact(Input, Output, nWidth, nHeight, nRadius, nRadius / 2.0, dSigmaRange, 0))
+		return 0;
+
+	return nWidth * nHeight;
+}
+
+/*
+ * @Function Name : GetVerifyResize
+ * @Descriotion : nParam으로 Resize 방식(Bilinear, Area)과 출력 크기 결정
+ *                가로 1/8 ~ 2배, 세로 1/8 ~ 1배, 출력이 검증 버퍼(max(nWidth x nHeight, VERIFY_MIN_OUTPUT))를 넘지 않도록 세로를 줄임
+ * @Input : nParam, nWidth, nHeight
+ * @Output : *pOutWidth, *pOutHeight, *pMode
+ */
+void GetVerifyResize(int nParam, int nWidth, int nHeight, int* pOutWidth, int* pOutHeight, int* pMode)
+{
+	int nCapacity = nWidth * nHeight > VERIFY_MIN_OUTPUT ? nWidth * nHeight : VERIFY_MIN_OUTPUT;
+
+	*pMode = RESIZE_BILINEAR + nParam % 2;
+	*pOutWidth = nWidth * (1 + (nParam / 2) % 16) / 8;
+	*pOutHeight = nHeight * (1 + (nParam / 32) % 8) / 8;
+
+	if (*pOutWidth < 1)
+		*pOutWidth = 1;
+	if (*pOutHeight < 1)
+		*pOutHeight = 1;
+	if (*pOutWidth * *pOutHeight > nCapacity)
+		*pOutHeight = nCapacity / *pOutWidth;
+
+	return;
+}
+
+/*
+ * @Function Name : VerifyResizeScalar
+ * @Descriotion : 기준 - ResizeImage와 같은 계수 표로 출력 픽셀마다 가로(Q7 반올림) -> 세로 가중합을 직접 계산 (중간 행 캐시와 SSE2 없음)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyResizeScalar(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	RESIZE_TABLE TableX, TableY;
+	int nOutWidth, nOutHeight, nMode;
+	int nInterShift = RESIZE_WEIGHT_BITS - RESIZE_INTER_BITS;
+	int nShift = RESIZE_WEIGHT_BITS + RESIZE_INTER_BITS;
+
+	GetVerifyResize(nParam, nWidth, nHeight, &nOutWidth, &nOutHeight, &nMode);
+
+	if (0 == BuildResizeTable(&TableX, nWidth, nOutWidth, nMode))
+		return 0;
+	if (0 == BuildResizeTable(&TableY, nHeight, nOutHeight, nMode)) {
+		DestroyResizeTable(&TableX);
+		return 0;
+	}
+
+	for (int y = 0; y < nOutHeight; y++) {
+		for (int x = 0; x < nOutWidth; x++) {
+			int nSum = 0;
+
+			for (int k = 0; k < TableY.nTaps; k++) {
+				BYTE* pSrc = &Input[TableY.Index[y * TableY.nTaps + k] * nWidth];
+				int nInter = 0;
+
+				for (int t = 0; t < TableX.nTaps; t++)
+					nInter += pSrc[TableX.Index[x * TableX.nTaps + t]] * TableX.Weight[x * TableX.nTaps + t];
+
+				nInter = (nInter + (1 << (nInterShift - 1))) >> nInterShift;
+				nSum += nInter * TableY.Weight[y * TableY.nTaps + k];
+			}
+
+			nSum = (nSum + (1 << (nShift - 1))) >> nShift;
+			Output[y * nOutWidth + x] = (BYTE)(nSum < 0 ? 0 : (nSum > 255 ? 255 : nSum));
+		}
+	}
+
+	DestroyResizeTable(&TableX);
+	DestroyResizeTable(&TableY);
+
+	return nOutWidth * nOutHeight;
+}
+
+/*
+ * @Function Name : VerifyResizeImage
+ * @Descriotion : 변형 - ResizeImage (SSE2 가로/세로 처리, 중간 행 캐시, 행 띠 병렬)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyResizeImage(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nOutWidth, nOutHeight, nMode;
+
+	GetVerifyResize(nParam, nWidth, nHeight, &nOutWidth, &nOutHeight, &nMode);
+
+	if (0 == ResizeImage(Input, Output, nWidth, nHeight, nOutWidth, nOutHeight, nMode))
+		return 0;
+
+	return nOutWidth * nOutHeight;
+}
+
+#define VERIFY_MAX_TEMPLATE	22			// 검증 Template 최대 크기 (1 + 3 x 7)
+
+/*
+ * @Function Name : GetVerifyTemplate
+ * @Descriotion : nParam으로 방식(SSD, NCC)과 Template 크기(1 ~ VERIFY_MAX_TEMPLATE, 영상 이하)를 정하고
+ *                입력의 한 부분을 잘라 하위 2비트를 바꾼 Template 생성 (정확히 일치하지 않는 위치 포함)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Template, *pTWidth, *pTHeight, 방식
+ */
+int GetVerifyTemplate(BYTE* Input, int nWidth, int nHeight, int nParam, BYTE* Template, int* pTWidth, int* pTHeight)
+{
+	int nTWidth = 1 + 3 * ((nParam / 2) % 8);
+	int nTHeight = 1 + 3 * ((nParam / 16) % 8);
+	int x0, y0;
+
+	if (nTWidth > nWidth)
+		nTWidth = nWidth;
+	if (nTHeight > nHeight)
+		nTHeight = nHeight;
+
+	x0 = (nParam * 7) % (nWidth - nTWidth + 1);
+	y0 = (nParam * 13) % (nHeight - nTHeight + 1);
+
+	for (int m = 0; m < nTHeight; m++)
+		for (int n = 0; n < nTWidth; n++)
+			Template[m * nTWidth + n] = Input[(y0 + m) * nWidth + x0 + n] ^ ((m + n) & 3);
+
+	*pTWidth = nTWidth;
+	*pTHeight = nTHeight;
+
+	return MATCH_SSD + nParam % 2;
+}
+
+/*
+ * @Function Name : QuantizeMatchScore
+ * @Descriotion : 점수 비교용 0 ~ 255 변환 (SSD : 화소당 RMS 차이, NCC : -1 ~ 1 -> 0 ~ 255)
+ * @Input : nMethod, dScore, n (Template 화소 수)
+ * @Output : 변환 값
+ */
+BYTE QuantizeMatchScore(int nMethod, double dScore, double n)
+{
+	double dValue;
+
+	if (MATCH_SSD == nMethod)
+		dValue = dScore > 0.0 ? sqrt(dScore / n) : 0.0;
+	else
+		dValue = dScore * 127.5 + 127.5;
+
+	return (BYTE)(dValue < 0.0 ? 0 : (dValue > 255.0 ? 255 : dValue + 0.5));
+}
+
+/*
+ * @Function Name : VerifyMatchDirect
+ * @Descriotion : 기준 - 위치마다 합, 제곱합, 상관 항을 직접 누적하여 MatchScore (적분 영상, SSE2, FFT 없음)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수
+ */
+int VerifyMatchDirect(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	BYTE Template[VERIFY_MAX_TEMPLATE * VERIFY_MAX_TEMPLATE];
+	int nTWidth, nTHeight;
+	int nMethod = GetVerifyTemplate(Input, nWidth, nHeight, nParam, Template, &nTWidth, &nTHeight);
+	int nOutWidth = nWidth - nTWidth + 1, nOutHeight = nHeight - nTHeight + 1;
+	double n = (double)nTWidth * nTHeight;
+	double dTSum = 0.0, dTSqSum = 0.0;
+
+	for (int i = 0; i < nTWidth * nTHeight; i++) {
+		dTSum += Template[i];
+		dTSqSum += (double)Template[i] * Template[i];
+	}
+
+	for (int y = 0; y < nOutHeight; y++) {
+		for (int x = 0; x < nOutWidth; x++) {
+			long long llSum = 0, llSqSum = 0, llCross = 0;
+
+			for (int m = 0; m < nTHeight; m++) {
+				for (int k = 0; k < nTWidth; k++) {
+					int v = Input[(y + m) * nWidth + x + k];
+
+					llSum += v;
+					llSqSum += v * v;
+					llCross += v * Template[m * nTWidth + k];
+				}
+			}
+
+			Output[y * nOutWidth + x] = QuantizeMatchScore(nMethod,
+				MatchScore(nMethod, (double)llSum, (double)llSqSum, (double)llCross, dTSum, dTSqSum, n), n);
+		}
+	}
+
+	return nOutWidth * nOutHeight;
+}
+
+/*
+ * @Function Name : VerifyMatchScores
+ * @Descriotion : ComputeMatchScores를 nCross 방식으로 수행하고 점수를 0 ~ 255로 변환
+ * @Input : *Input, nWidth, nHeight, nParam, nCross
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyMatchScores(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam, int nCross)
+{
+	BYTE Template[VERIFY_MAX_TEMPLATE * VERIFY_MAX_TEMPLATE];
+	int nTWidth, nTHeight;
+	int nMethod = GetVerifyTemplate(Input, nWidth, nHeight, nParam, Template, &nTWidth, &nTHeight);
+	int nOutSize = (nWidth - nTWidth + 1) * (nHeight - nTHeight + 1);
+	double* Score = (double*)malloc(sizeof(double) * nOutSize);
+	int nResult = 0;
+
+	if (NULL != Score && ComputeMatchScores(Input, nWidth, nHeight, Template, nTWidth, nTHeight, nMethod, nCross, Score)) {
+		for (int i = 0; i < nOutSize; i++)
+			Output[i] = QuantizeMatchScore(nMethod, Score[i], (double)nTWidth * nTHeight);
+		nResult = nOutSize;
+	}
+
+	free(Score);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : VerifyMatchDotProduct
+ * @Descriotion : 변형 - ComputeMatchScores (적분 영상 + SSE2 DotProductRow 상관 항)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyMatchDotProduct(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	return VerifyMatchScores(Input, Output, nWidth, nHeight, nParam, MATCH_CROSS_DIRECT);
+}
+
+/*
+ * @Function Name : VerifyMatchFFT
+ * @Descriotion : 변형 - ComputeMatchScores (적분 영상 + FFTCrossCorrelation 상관 항)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyMatchFFT(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	return VerifyMatchScores(Input, Output, nWidth, nHeight, nParam, MATCH_CROSS_FFT);
+}
+
+/*
+ * @Function Name : VerifyLabeling
+ * @Descriotion : nParam 임계값으로 이진화한 영상을 nBands개 띠로 Labeling하여 Label 하위 바이트 출력 (연결성 : 짝수 4, 홀수 8)
+ * @Input : *Input, nWidth, nHeight, nParam, nBands
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyLabeling(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam, int nBands)
+{
+	int* Labels = (int*)malloc(sizeof(int) * nWidth * nHeight);
+	BLOB_STATS* Stats = NULL;
+	int nResult = 0;
+
+	if (NULL == Labels)
+		return 0;
+
+	// Output을 이진 영상 버퍼로 먼저 사용
+	GenerateBinarization(Input, Output, nWidth, nHeight, (BYTE)nParam);
+
+	if (LabelConnectedComponentsBands(Output, nWidth, nHeight, (nParam & 1) ? 8 : 4, Labels, &Stats, nBands) >= 0) {
+		for (int i = 0; i < nWidth * nHeight; i++)
+			Output[i] = (BYTE)Labels[i];
+		nResult = nWidth * nHeight;
+	}
+
+	free(Labels);
+	free(Stats);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : VerifyLabelSingleBand
+ * @Descriotion : 기준 - LabelConnectedComponentsBands (띠 1개, 경계 병합 없음)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyLabelSingleBand(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	return VerifyLabeling(Input, Output, nWidth, nHeight, nParam, 1);
+}
+
+/*
+ * @Function Name : VerifyLabelMultiBand
+ * @Descriotion : 변형 - LabelConnectedComponentsBands (띠 2 ~ MAX_THREADS개, 높이 이하, 띠 경계 Run 병합)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (실패 0)
+ */
+int VerifyLabelMultiBand(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nBands = 2 + nParam % (MAX_THREADS - 1);
+
+	return VerifyLabeling(Input, Output, nWidth, nHeight, nParam, nBands < nHeight ? nBands : nHeight);
+}
+
+/*
+ * @Function Name : VerifyCannyUnfused
+ * @Descriotion : 기준 - 영상 전체 크기 버퍼로 단계별 Canny (GaussianConvolution -> 전체 기울기 -> 전체 NMS -> 같은 임계값 -> Queue 기반 Hysteresis)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyCannyUnfused(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	int nImgSize = nWidth * nHeight;
+	int nHisto[256] = { 0, };
+	int nHead = 0, nTail = 0;
+	BYTE bLow, bHigh;
+
+	if (nWidth < 3 || nHeight < 3) {
+		memset(Output, 0, nImgSize);
+		return nImgSize;
+	}
+
+	BYTE* Smooth = (BYTE*)malloc(nImgSize);
+	BYTE* Mag = (BYTE*)malloc(nImgSize);
+	BYTE* Dir = (BYTE*)malloc(nImgSize);
+	int* Queue = (int*)malloc(sizeof(int) * nImgSize);
+
+	if (NULL == Smooth || NULL == Mag || NULL == Dir || NULL == Queue) {
+		free(Smooth);
+		free(Mag);
+		free(Dir);
+		free(Queue);
+		return 0;
+	}
+
+	// 1. 평활화 (경계는 원본)
+	memcpy(Smooth, Input, nImgSize);
+	GaussianConvolution(Input, Smooth, nWidth, nHeight);
+
+	// 2. 기울기 (경계 행은 0)
+	memset(Mag, 0, nImgSize);
+	memset(Dir, 0, nImgSize);
+	for (int i = 1; i < nHeight - 1; i++)
+		CannyGradientRow(&Smooth[(i - 1) * nWidth], &Smooth[i * nWidth], &Smooth[(i + 1) * nWidth], &Mag[i * nWidth], &Dir[i * nWidth], nWidth);
+
+	for (int i = 0; i < nImgSize; i++)
+		nHisto[Mag[i]]++;
+
+	// 3. 비최대 억제
+	memset(Output, 0, nImgSize);
+	for (int i = 1; i < nHeight - 1; i++) {
+		for (int j = 1; j < nWidth - 1; j++) {
+			int p = i * nWidth + j;
+			BYTE bA, bB;
+
+			switch (Dir[p]) {
+			case 0: bA = Mag[p - 1];          bB = Mag[p + 1];          break;
+			case 1: bA = Mag[p - nWidth - 1]; bB = Mag[p + nWidth + 1]; break;
+			case 2: bA = Mag[p - nWidth];     bB = Mag[p + nWidth];     break;
+			default: bA = Mag[p - nWidth + 1]; bB = Mag[p + nWidth - 1]; break;
+			}
+
+			Output[p] = (Mag[p] > bA && Mag[p] >= bB) ? Mag[p] : 0;
+		}
+	}
+
+	// 4. CannyEdgeDetection과 같은 임계값
+	bHigh = GonzalezMethod(nHisto);
+	if (bHigh < 2)
+		bHigh = 2;
+	bLow = (BYTE)(0.4 * bHigh);
+	if (bLow < 1)
+		bLow = 1;
+
+	// 5. 강한 Edge에서 시작하여 8방향으로 연결된 약한 Edge 후보를 너비 우선으로 승격
+	for (int i = 0; i < nImgSize; i++) {
+		if (Output[i] >= bHigh) {
+			Output[i] = 255;
+			Queue[nTail++] = i;
+		}
+		else
+			Output[i] = (Output[i] >= bLow) ? 1 : 0;
+	}
+
+	while (nHead < nTail) {
+		int nIdx = Queue[nHead++];
+
+		for (int m = -1; m <= 1; m++) {
+			for (int n = -1; n <= 1; n++) {
+				int nNext = nIdx + m * nWidth + n;
+
+				if (1 == Output[nNext]) {
+					Output[nNext] = 255;
+					Queue[nTail++] = nNext;
+				}
+			}
+		}
+	}
+
+	for (int i = 0; i < nImgSize; i++)
+		if (1 == Output[i])
+			Output[i] = 0;
+
+	free(Smooth);
+	free(Mag);
+	free(Dir);
+	free(Queue);
+
+	return nImgSize;
+}
+
+/*
+ * @Function Name : VerifyCannyFused
+ * @Descriotion : 변형 - CannyEdgeDetection (행 버퍼 3개로 평활화/기울기/NMS 스트리밍, Stack 기반 Hysteresis)
+ * @Input : *Input, nWidth, nHeight, nParam
+ * @Output : *Output, 출력 바이트 수 (메모리 할당 실패 0)
+ */
+int VerifyCannyFused(BYTE* Input, BYTE* Output, int nWidth, int nHeight, int nParam)
+{
+	BYTE bLow, bHigh;
+
+	if (0 == CannyEdgeDetection(Input, Output, nWidth, nHeight, &bLow, &bHigh))
+		return 0;
+
+	return nWidth * nHeight;
+}
+
+// 검증할 기준 / 변형 쌍 (Packed / RLE8 변형 시간에는 8비트로 풀어내는 시간이 포함됨)
+VERIFY_CASE g_VerifyCase[] = {
+	{ "AverageConvolution / KernelConvolution",		VerifyAverage,				VerifyAverageKernel,		0, 0 },
+	{ "GaussianConvolution / KernelConvolution",	VerifyGaussian,				VerifyGaussianKernel,		0, 0 },
+	{ "DirectConvolution / FFTConvolution",			VerifyDirectConvolution,	VerifyFFTConvolution,		1, 10 },
+	{ "GenerateBinarization / Packed (SSE2)",		VerifyBinarization,			VerifyPackedBinarization,	0, 128 },
+	{ "GenerateBinarization / RLE8",				VerifyBinarization,			VerifyRLEBinarization,		0, 128 },
+	{ "PoolWindow / StridedPooling",				VerifyPoolWindow,			VerifyStridedPooling,		0, 7 },
+	{ "GenerateHistogram / GetImageStats",			VerifyHistogram,			VerifyStatsHistogram,		0, 0 },
+	{ "GonzalezMethod / GonzalezMethodRange",		VerifyGonzalez,				VerifyStatsGonzalez,		0, 0 },
+	{ "HistogramStretching / Range + Stats",		VerifyStretching,			VerifyStatsStretching,		0, 0 },
+	{ "HistogramEqualization / Stats",				VerifyEqualization,			VerifyStatsEqualization,	0, 0 },
+	{ "Disk Morphology brute force / EDT",			VerifyDiskBruteForce,		VerifyDiskMorphology,		0, 15 },
+	{ "BilateralFilterExact Scalar / SSE2",			VerifyBilateralScalar,		VerifyBilateralSSE,			0, 34 },
+	{ "Resize Scalar / ResizeImage (SSE2)",			VerifyResizeScalar,			VerifyResizeImage,			0, 138 },
+	{ "Match direct / DotProductRow (SSE2)",		VerifyMatchDirect,			VerifyMatchDotProduct,		0, 91 },
+	{ "Match direct / FFTCrossCorrelation",			VerifyMatchDirect,			VerifyMatchFFT,				1, 91 },
+	{ "Labeling single band / multi band",			VerifyLabelSingleBand,		VerifyLabelMultiBand,		0, 128 },
+	{ "Canny unfused / fused",						VerifyCannyUnfused,			VerifyCannyFused,			0, 0 },
+};
+
+#define VERIFY_CASES	(int)(sizeof(g_VerifyCase) / sizeof(g_VerifyCase[0]))
+
+/*
+ * @Function Name : VerifyRandom
+ * @Descriotion : xorshift64* 의사 난수 (Seed가 같으면 같은 시행을 재현)
+ * @Input : *pState
+ * @Output : 0 ~ 2^31-1 난수, *pState
+ */
+int VerifyRandom(ULONGLONG* pState)
+{
+	*pState ^= *pState >> 12;
+	*pState ^= *pState << 25;
+	*pState ^= *pState >> 27;
+
+	return (int)((*pState * 0x2545F4914F6CDD1DULL) >> 33);
+}
+
+/*
+ * @Function Name : VerifySeedState
+ * @Descriotion : Seed, 쌍 번호, 시행 번호를 splitmix64로 섞어 시행별 난수 상태 생성
+ *                (앞선 시행이나 시행 수와 무관하게 같은 세 값이면 같은 입력)
+ * @Input : nSeed, nCase, nTrial
+ * @Output : 0이 아닌 xorshift64* 상태
+ */
+ULONGLONG VerifySeedState(unsigned int nSeed, int nCase, int nTrial)
+{
+	ULONGLONG ullState = ((ULONGLONG)nSeed << 32) ^ ((ULONGLONG)(unsigned int)nCase << 20) ^ (ULONGLONG)(unsigned int)nTrial;
+
+	ullState += 0x9E3779B97F4A7C15ULL;
+	ullState = (ullState ^ (ullState >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	ullState = (ullState ^ (ullState >> 27)) * 0x94D049BB133111EBULL;
+	ullState ^= ullState >> 31;
+
+	return ullState ? ullState : 0x9E3779B97F4A7C15ULL;
+}
+
+/*
+ * @Function Name : FillVerifyPattern
+ * @Descriotion : 검증 입력 패턴 생성
+ *                0 : 무작위, 1 : 모두 0, 2 : 모두 255, 3 : 0 / 255 체크무늬, 4 : 0 / 255 잡음, 5 : 128 근처(+-1)
+ * @Input : nWidth, nHeight, nPattern, *pState
+ * @Output : *Buffer
+ */
+void FillVerifyPattern(BYTE* Buffer, int nWidth, int nHeight, int nPattern, ULONGLONG* pState)
+{
+	for (int i = 0; i < nHeight; i++) {
+		for (int j = 0; j < nWidth; j++) {
+			BYTE bValue;
+
+			switch (nPattern) {
+			case 1:  bValue = 0; break;
+			case 2:  bValue = 255; break;
+			case 3:  bValue = ((i + j) & 1) ? 255 : 0; break;
+			case 4:  bValue = (VerifyRandom(pState) & 1) ? 255 : 0; break;
+			case 5:  bValue = (BYTE)(127 + VerifyRandom(pState) % 3); break;
+			default: bValue = (BYTE)VerifyRandom(pState); break;
+			}
+
+			Buffer[i * nWidth + j] = bValue;
+		}
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : RunVerifyTrial
+ * @Descriotion : 무작위 크기 / 인자 / 패턴 / 버퍼 정렬로 기준과 변형을 한 번씩 수행하여 비교
+ *                시행 번호 4로 나눈 나머지 0 : 폭 1 ~ 3, 1 : 높이 1 ~ 3, 2 : 홀수 폭, 3 : 임의 크기
+ * @Input : *Case, nSeed, nCase, nTrial
+ * @Output : *Result, 통과 1, 불일치 / 실패 0, 메모리 할당 실패 -1
+ */
+int RunVerifyTrial(VERIFY_CASE* Case, VERIFY_RESULT* Result, unsigned int nSeed, int nCase, int nTrial)
+{
+	ULONGLONG ullState = VerifySeedState(nSeed, nCase, nTrial);
+	int nWidth = 1 + VerifyRandom(&ullState) % VERIFY_MAX_WIDTH;
+	int nHeight = 1 + VerifyRandom(&ullState) % VERIFY_MAX_HEIGHT;
+	int nParam = VerifyRandom(&ullState) % 256;
+	int nPattern = VerifyRandom(&ullState) % 6;
+	int nInAlign = VerifyRandom(&ullState) % VERIFY_MAX_ALIGN;
+	int nRefAlign = VerifyRandom(&ullState) % VERIFY_MAX_ALIGN;
+	int nVarAlign = VerifyRandom(&ullState) % VERIFY_MAX_ALIGN;
+	int nImgSize, nCapacity, nRefSize, nVarSize;
+	int nDiffs = 0, nFirst = -1, nMaxDiff = 0;
+	int nResult = -1;
+	BYTE *InBlock = NULL, *Copy = NULL, *RefBlock = NULL, *VarBlock = NULL;
+	BYTE *Input, *Ref, *Var;
+	const char* Reason = NULL;
+
+	switch (nTrial % 4) {
+	case 0:  nWidth = 1 + nWidth % 3; break;
+	case 1:  nHeight = 1 + nHeight % 3; break;
+	case 2:  nWidth |= 1; break;
+	}
+
+	nImgSize = nWidth * nHeight;
+	nCapacity = nImgSize > VERIFY_MIN_OUTPUT ? nImgSize : VERIFY_MIN_OUTPUT;
+
+	InBlock = (BYTE*)malloc(nImgSize + VERIFY_MAX_ALIGN);
+	Copy = (BYTE*)malloc(nImgSize);
+	RefBlock = (BYTE*)malloc(nCapacity + VERIFY_MAX_ALIGN + VERIFY_GUARD);
+	VarBlock = (BYTE*)malloc(nCapacity + VERIFY_MAX_ALIGN + VERIFY_GUARD);
+	if (NULL == InBlock || NULL == Copy || NULL == RefBlock || NULL == VarBlock)
+		goto CLEANUP;
+
+	Input = InBlock + nInAlign;
+	Ref = RefBlock + nRefAlign;
+	Var = VarBlock + nVarAlign;
+
+	FillVerifyPattern(Input, nWidth, nHeight, nPattern, &ullState);
+	memcpy(Copy, Input, nImgSize);
+	memset(RefBlock, VERIFY_FILL, nCapacity + VERIFY_MAX_ALIGN + VERIFY_GUARD);
+	memset(VarBlock, VERIFY_FILL, nCapacity + VERIFY_MAX_ALIGN + VERIFY_GUARD);
+
+	nRefSize = Case->Reference(Input, Ref, nWidth, nHeight, nParam);
+	nVarSize = Case->Variant(Input, Var, nWidth, nHeight, nParam);
+
+	// 출력 크기 뒤의 영역까지 비교하여 변형만 쓴 바이트도 불일치로 검출
+	for (int i = 0; i < nCapacity; i++) {
+		int nDiff = abs(Ref[i] - Var[i]);
+
+		if (nDiff > nMaxDiff)
+			nMaxDiff = nDiff;
+		if (nDiff > Case->nTolerance) {
+			if (nFirst < 0)
+				nFirst = i;
+			nDiffs++;
+		}
+	}
+
+	if (nVarSize != nRefSize)
+		Reason = "output size";
+	else if (0 != memcmp(Copy, Input, nImgSize))
+		Reason = "input modified";
+	else {
+		for (int i = 0; i < VERIFY_GUARD; i++) {
+			if (VERIFY_FILL != Var[nCapacity + i] || VERIFY_FILL != Ref[nCapacity + i]) {
+				Reason = "guard overwritten";
+				break;
+			}
+		}
+	}
+
+	Result->nTrials++;
+	if (nMaxDiff > Result->nMaxDiff)
+		Result->nMaxDiff = nMaxDiff;
+
+	if (NULL != Reason)
+		Result->nFailures++;
+	else if (nDiffs > 0)
+		Result->nMismatches++;
+
+	nResult = (NULL == Reason && 0 == nDiffs);
+
+	// 재현에 필요한 정보 출력 (Seed, 쌍 번호, 시행 번호가 같으면 같은 입력)
+	if (0 == nResult && Result->nReports < VERIFY_MAX_REPORTS) {
+		Result->nReports++;
+		printf("  %s : seed %u, case %d, trial %d, %d x %d, param %d, pattern %d, align %d/%d/%d",
+			Case->Name, nSeed, nCase, nTrial, nWidth, nHeight, nParam, nPattern, nInAlign, nRefAlign, nVarAlign);
+		if (NULL != Reason)
+			printf(" - %s (ref %d, var %d)\n", Reason, nRefSize, nVarSize);
+		else
+			printf(" - %d bytes differ, first at %d (ref %d, var %d), max diff %d\n", nDiffs, nFirst, Ref[nFirst], Var[nFirst], nMaxDiff);
+	}
+
+CLEANUP:
+	free(InBlock);
+	free(Copy);
+	free(RefBlock);
+	free(VarBlock);
+
+	return nResult;
+}
+
+/*
+ * @Function Name : BenchVerifyCase
+ * @Descriotion : VERIFY_BENCH_WIDTH x VERIFY_BENCH_HEIGHT 무작위 영상으로 기준과 변형의 수행 시간을 측정 (VERIFY_BENCH_RUNS회 중 최소)
+ * @Input : *Case, *Input, *Output
+ * @Output : Result->dRefTime, dVarTime
+ */
+void BenchVerifyCase(VERIFY_CASE* Case, VERIFY_RESULT* Result, BYTE* Input, BYTE* Output)
+{
+	LARGE_INTEGER Start, End;
+	double dTime;
+
+	Result->dRefTime = Result->dVarTime = 0.0;
+
+	for (int r = 0; r < VERIFY_BENCH_RUNS; r++) {
+		QueryPerformanceCounter(&Start);
+		Case->Reference(Input, Output, VERIFY_BENCH_WIDTH, VERIFY_BENCH_HEIGHT, Case->nBenchParam);
+		QueryPerformanceCounter(&End);
+
+		dTime = GetElapsedTime(Start, End);
+		if (0 == r || dTime < Result->dRefTime)
+			Result->dRefTime = dTime;
+
+		QueryPerformanceCounter(&Start);
+		Case->Variant(Input, Output, VERIFY_BENCH_WIDTH, VERIFY_BENCH_HEIGHT, Case->nBenchParam);
+		QueryPerformanceCounter(&End);
+
+		dTime = GetElapsedTime(Start, End);
+		if (0 == r || dTime < Result->dVarTime)
+			Result->dVarTime = dTime;
+	}
+
+	return;
+}
+
+/*
+ * @Function Name : RunVerification
+ * @Descriotion : 모든 기준 / 변형 쌍을 nTrials번씩 무작위 입력으로 비교하고 속도 향상과 함께 결과 표 출력
+ * @Input : nTrials, nSeed
+ * @Output : 불일치 또는 실패가 있는 쌍의 수 (메모리 할당 실패 -1)
+ */
+int RunVerification(int nTrials, unsigned int nSeed)
+{
+	VERIFY_RESULT Result[VERIFY_CASES];
+	ULONGLONG ullState = VerifySeedState(nSeed, VERIFY_CASES, 0);		// 속도 측정 입력은 쌍 번호 다음 값으로 생성
+	int nBenchSize = VERIFY_BENCH_WIDTH * VERIFY_BENCH_HEIGHT;
+	int nFailed = 0;
+	BYTE* Input = AllocFrame(nBenchSize, VERIFY_BENCH_HEIGHT);
+	BYTE* Output = AllocFrame(nBenchSize, VERIFY_BENCH_HEIGHT);
+
+	if (NULL == Input || NULL == Output) {
+		FreeFrame(Input);
+		FreeFrame(Output);
+		return -1;
+	}
+
+	memset(Result, 0, sizeof(Result));
+	FillVerifyPattern(Input, VERIFY_BENCH_WIDTH, VERIFY_BENCH_HEIGHT, 0, &ullState);
+
+	for (int c = 0; c < VERIFY_CASES; c++) {
+		for (int t = 0; t < nTrials; t++) {
+			if (RunVerifyTrial(&g_VerifyCase[c], &Result[c], nSeed, c, t) < 0) {
+				FreeFrame(Input);
+				FreeFrame(Output);
+				return -1;
+			}
+		}
+
+		BenchVerifyCase(&g_VerifyCase[c], &Result[c], Input, Output);
+	}
+
+	printf("\n%-44s %7s %8s %8s %8s %10s %10s %8s\n", "Reference / Variant", "Trials", "Mismatch", "Failure", "MaxDiff", "Ref(ms)", "Var(ms)", "Speedup");
+	for (int c = 0; c < VERIFY_CASES; c++) {
+		printf("%-44s %7d %8d %8d %8d %10.3f %10.3f %7.2fx\n", g_VerifyCase[c].Name,
+			Result[c].nTrials, Result[c].nMismatches, Result[c].nFailures, Result[c].nMaxDiff,
+			Result[c].dRefTime * 1000.0, Result[c].dVarTime * 1000.0,
+			Result[c].dVarTime > 0.0 ? Result[c].dRefTime / Result[c].dVarTime : 0.0);
+
+		if (Result[c].nMismatches > 0 || Result[c].nFailures > 0)
+			nFailed++;
+	}
+
+	FreeFrame(Input);
+	FreeFrame(Output);
+
+	return nFailed;
+}
+
+/*
+ * @Function Name : main
+ * @Descriotion : Image Processing main 함수로 switch 문에 따라 함수를 호출하여 기능을 수행
+ * @Input :
+ * @Output :
+ */
+void main()
+{
+	// BMT Header 구조체 선언
+	BITMAPFILEHEADER hf; // BMP 파일헤더 14Bytes
+	BITMAPINFOHEADER hInfo; // BMP 인포헤더 40Bytes
+	RGBQUAD hRGB[256] = { 0, };// 파레트 (256 * 4Bytes)
+
+	// 변수 선언
+	FILE* fp = NULL;				// 파일 포인터
+	errno_t nErr = 0;				// Error	
+	int nImgSize = 0;				// 이미지 크기
+
+	// ver 0.2 변수 추가
+	int nBrigntness = 0;	// 밝기 값
+	double dContrast = 0;		// 대비 값
+
+	// ver 0.3 변수 추가
+	BYTE bThreshold;
+	int nThreshold = 0;			// threshold를 입력
+
+	// ver 0.8 변수 추가
+	int nKSize = 0;				// Kernel 크기 (홀수)
+	double* Kernel = NULL;		// nKSize x nKSize Kernel
+
+	// ver 0.9 변수 추가
+	BYTE bLowThreshold, bHighThreshold;		// Canny Hysteresis 임계값
+
+	// ver 1.0 변수 추가
+	int nOutSize = 0;			// 출력 이미지 데이터 크기 (기본 nImgSize)
+	int nPalette = 256;			// 출력 파레트 개수
+
+	// ver 1.1 변수 추가
+	int nConnectivity = 8;		// Labeling 연결성 (4 또는 8)
+	int nComponents = 0;		// Component 수
+	BLOB_STATS* Blobs = NULL;	// Component별 통계
+
+	// ver 1.2 변수 추가
+	int nPoolSize = 2;			// Pooling 창 크기 (2 또는 3)
+	int nPoolType = POOL_MAX;	// Pooling 종류
+	int nLevels = 0;			// Pyramid Level 수
+	IMAGE_PYRAMID Pyramid;
+
+	// ver 1.3 변수 추가
+	int nResizeMode = RESIZE_BILINEAR;			// Resize 방식
+	int nOutWidth = 0, nOutHeight = 0;			// Resize 출력 크기
+
+	// ver 1.5 변수 추가
+	DAEMON_REQUEST Request = { 0, };			// Daemon 요청 (Pipeline)
+
+	// ver 1.6 변수 추가
+	int nOperation = 0, nParam = 0;				// Cache 연산 번호, 인자
+
+	// ver 1.7 변수 추가
+	ROI Roi = { 0, };							// ROI 사각형 목록, Mask
+	CHAR MaskPath[256] = { 0, };				// Mask 파일 경로 ("-"이면 없음)
+	BYTE* RowNeeded = NULL;						// ROI + halo가 걸친 행
+	long long llRoiRead = 0;					// ROI 처리에서 읽은 화소 바이트
+
+	// ver 1.8 변수 추가
+	CHAR TemplatePath[256] = { 0, };			// Template 파일 경로
+	BYTE* Template = NULL;
+	int nTWidth = 0, nTHeight = 0;				// Template 크기
+	int nMatchMethod = 0, nMatchCount = 0;		// 1. SSD, 2. NCC / 찾을 개수
+	MATCH_RESULT Matches[MAX_MATCHES];
+
+	// ver 1.9 변수 추가
+	int nRadius = 0;							// Bilateral 반경
+	double dSigmaRange = 0.0;					// Bilateral 밝기 sigma
+
+	// ver 2.0 변수 추가
+	CHAR ListPath[256] = { 0, };				// 일괄 처리 목록 파일 경로
+	int bDirect = 0;							// NO_BUFFERING 읽기 사용
+
+	// ver 2.2 변수 추가
+	IMAGE_STATS Stats = { 0, };					// 읽기 시점 영상 통계 (Input 버퍼)
+
+	// ver 2.3 변수 추가
+	int nTrials = 0;							// 검증 시행 수 (쌍마다)
+	unsigned int nSeed = 0;						// 검증 난수 Seed
+	int nFailed = 0;							// 불일치가 있는 쌍의 수
+
+	// ver 2.4 변수 추가
+	int nEDTMode = 0;							// 0 : 거리 영상, 1 : 팽창, 2 : 침식
+	WORD* Distance = NULL;						// 가장자리까지 거리
+
+	int nMode = 0;					// 기능 선택
+	CHAR PATH[256] = { 0, };		// 파일 경로
+
+	// 사용자 입력
+	printf("=================================\n\n");
+	printf("Image Processing Program\n\n");
+	printf("1.  Inverse Image\n");
+	printf("2.  Adjust Brightness\n");
+	printf("3.  Adjust Contrast\n");
+	printf("4.  Generate Histogram\n");
+	printf("5.  Generate Binarization - Gonzalez Method\n");
+	printf("6.  Generate Binarization\n");
+	printf("7.  Histogram Stretching\n");
+	printf("8.  Histogram Equalization\n");
+	printf("9.  Average Convolution\n");
+	printf("10. Gaussian Convolution\n");
+	printf("11. Laplacian Convolution\n");
+	printf("12. Prewitt X Convolution\n");
+	printf("13. Prewitt Y Convolution\n");
+	printf("14. Prewitt Convolution\n");
+	printf("15. Sobel X Convolution\n");
+	printf("16. Sobel Y Convolution\n");
+	printf("17. Sobel Convolution\n");
+	printf("18. Laplacian High Pass Filter Convolution\n");
+	printf("19. Meadian Filter, Min Pooling, Min Pooling, Max Pooling\n");
+	printf("20. Large Kernel Gaussian Convolution (Direct / FFT)\n");
+	printf("21. Canny Edge Detection\n");
+	printf("22. Generate Binarization - 1bpp Packed\n");
+	printf("23. Generate Binarization - RLE8\n");
+	printf("24. Connected Component Labeling - Gonzalez Method\n");
+	printf("25. Strided Pooling (2x2, 3x3)\n");
+	printf("26. Gaussian Pyramid\n");
+	printf("27. Gaussian Pyramid Reduce - Expand\n");
+	printf("28. Resize (Nearest, Bilinear, Area)\n");
+	printf("29. Daemon Mode (Named Pipe + Shared Memory)\n");
+	printf("30. Daemon Client - Pipeline\n");
+	printf("31. Cached Operation (Result Cache)\n");
+	printf("32. ROI Processing (Rectangles + Mask)\n");
+	printf("33. Template Matching (SSD, NCC)\n");
+	printf("34. Bilateral Filter (Exact, Bilateral Grid)\n");
+	printf("35. Batch Processing (Async File I/O)\n");
+	printf("36. Differential Verification (Reference vs Optimized)\n");
+	printf("37. Distance Transform / Disk Morphology\n\n");
+	printf("=================================\n\n");
+
+	printf("원하는 기능의 번호를 입력하세요 : ");
+	scanf_s("%d", &nMode);
+
+	// Daemon 모드는 이미지 파일 없이 요청을 계속 처리
+	if (29 == nMode) {
+		RunDaemon();
+		return;
+	}
+
+	// 일괄 처리는 목록 파일의 이미지들을 읽어 연산 후 BATCH_OUTPUT_DIR에 저장
+	if (35 == nMode) {
+		printf("목록 파일의 경로를 입력하세요 : ");
+		scanf_s("%s", ListPath, sizeof(ListPath));
+		printf("연산 번호, 인자, NO_BUFFERING 사용(0, 1)을 입력하세요 : ");
+		scanf_s("%d %d %d", &nOperation, &nParam, &bDirect);
+
+		if (0 == RunBatch(ListPath, nOperation, nParam, bDirect))
+			printf("Error : batch error\n");
+
+		// 연산 중 기록된 진단 값 출력
+		FlushDiag();
+		return;
+	}
+
+	if (36 == nMode) {
+		printf("쌍마다 시행 수와 Seed를 입력하세요 : ");
+		scanf_s("%d %u", &nTrials, &nSeed);
+
+		if (nTrials < 1) {
+			printf("Error : input value error = %d\n", nTrials);
+			return;
+		}
+
+		nFailed = RunVerification(nTrials, nSeed);
+		if (nFailed < 0)
+			printf("Error : memory allocation error\n");
+		else
+			printf("\n불일치가 있는 쌍 : %d / %d (Seed %u)\n", nFailed, VERIFY_CASES, nSeed);
+		return;
+	}
+
+	printf("원본 이미지 파일의 경로를 입력하세요 : ");
+	scanf_s("%s", PATH, sizeof(PATH));
+
+	// 이미지 파일 오픈
+	nErr = fopen_s(&fp, PATH, "rb");
+
+	if (NULL == fp) {
+		printf("Error : file open error = %d\n", nErr);
+		return;
+	}
+
+	// BITMAPFILEHEADER
+	fread(&hf, sizeof(BITMAPFILEHEADER), 1, fp);
+
+	// BITMAPINFOHEADER
+	fread(&hInfo, sizeof(BITMAPINFOHEADER), 1, fp);
 
 	// RGBQUAD
 	fread(hRGB, sizeof(RGBQUAD), 256, fp);
@@ -695,26 +8240,76 @@ void main()
 
 	// 이미지 크기 계산(가로 X 세로)
 	nImgSize = hInfo.biWidth * hInfo.biHeight;
+	nOutSize = nImgSize;
 
-	// 원본 이미지와 출력 이미지를 저장할 버퍼 할당
-	BYTE* Input = (BYTE*)malloc(nImgSize);
-	BYTE* Output = (BYTE*)malloc(nImgSize);
+	// 원본 이미지와 출력 이미지를 저장할 버퍼 할당 (0으로 초기화, 행 띠 병렬 first-touch)
+	BYTE* Input = AllocFrame(nImgSize, hInfo.biHeight);
+	BYTE* Output = AllocFrame(nImgSize, hInfo.biHeight);
 
 	// Ver 0.5
-	BYTE* Temp = (BYTE*)malloc(nImgSize);		// prewitt convolution과 sobel convolution을 위해 임시 버퍼 생성
+	BYTE* Temp = AllocFrame(nImgSize, hInfo.biHeight);		// prewitt convolution과 sobel convolution을 위해 임시 버퍼 생성
 
 	if (NULL == Input || NULL == Output || NULL == Temp) {
 		printf("Error : memory allocation error\n");
 		return;
 	}
 
-	// 버퍼 초기화
-	memset(Input, 0, nImgSize);
-	memset(Output, 0, nImgSize);
-	memset(Temp, 0, nImgSize); // prewitt convolution과 sobel convolution을 위해 임시 버퍼 초기화
+	// ROI 처리는 ROI를 먼저 입력받아 필요한 행만 읽음
+	if (32 == nMode) {
+		printf("ROI 사각형 수(1 ~ %d)를 입력하세요 : ", MAX_ROI_RECTS);
+		scanf_s("%d", &Roi.nRects);
+
+		if (Roi.nRects < 1 || Roi.nRects > MAX_ROI_RECTS) {
+			printf("Error : input value error = %d\n", Roi.nRects);
+			fclose(fp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
 
-	// 
-	fread(Input, sizeof(BYTE), nImgSize, fp);
+		for (int i = 0; i < Roi.nRects; i++) {
+			printf("%d번째 사각형(x y 가로 세로)을 입력하세요 : ", i + 1);
+			scanf_s("%d %d %d %d", &Roi.Rect[i].nLeft, &Roi.Rect[i].nTop, &Roi.Rect[i].nWidth, &Roi.Rect[i].nHeight);
+		}
+
+		printf("Mask 파일 경로를 입력하세요 (없으면 -) : ");
+		scanf_s("%s", MaskPath, sizeof(MaskPath));
+		printf("연산 번호와 인자를 입력하세요 : ");
+		scanf_s("%d %d", &nOperation, &nParam);
+
+		RowNeeded = (BYTE*)malloc(hInfo.biHeight);
+
+		if (NULL == RowNeeded || GetRoiHalo(nOperation, nParam) < 0 || 0 == ClipRoi(&Roi, hInfo.biWidth, hInfo.biHeight)) {
+			printf("Error : input value error = %d, %d\n", nOperation, nParam);
+			fclose(fp);
+			free(RowNeeded);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		MarkRoiRows(&Roi, hInfo.biHeight, GetRoiHalo(nOperation, nParam), RowNeeded);
+		llRoiRead = ReadRoiRows(fp, ftell(fp), Input, hInfo.biWidth, hInfo.biHeight, RowNeeded);
+
+		if (0 != strcmp(MaskPath, "-"))
+			Roi.Mask = LoadRoiMask(MaskPath, hInfo.biWidth, hInfo.biHeight, RowNeeded);
+
+		free(RowNeeded);
+
+		if (llRoiRead < 0 || (0 != strcmp(MaskPath, "-") && NULL == Roi.Mask)) {
+			printf("Error : file read error\n");
+			fclose(fp);
+			free(Roi.Mask);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+	}
+	else
+		ReadImageWithStats(fp, Input, hInfo.biWidth, hInfo.biHeight, &Stats);
 	fclose(fp);
 
 	// nMode에 따라 기능을 계속 추가하면서 진행할 예정임
@@ -727,9 +8322,9 @@ void main()
 		nErr = fopen_s(&fp, "../inverse.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -745,9 +8340,9 @@ void main()
 		nErr = fopen_s(&fp, "../brigntness.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -762,42 +8357,42 @@ void main()
 
 		if (dContrast < 0) {
 			printf("Error : input value error = %d\n", dContrast);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
 		nErr = fopen_s(&fp, "../contrast.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
 		break;
 
 	case 4:
-		// Histogram 생성
-		GenerateHistogram(Input, nHisto, hInfo.biWidth, hInfo.biHeight);
+		// 읽을 때 계산한 Histogram 사용
+		GetImageStats(&Stats, Input, hInfo.biWidth, hInfo.biHeight);
 
 		// 히스토그램 값을 화면에 출력
 		for (int i = 0; i < 256; i++)
-			printf("%d, %d\n", i, nHisto[i]);
+			printf("%d, %d\n", i, Stats.nHisto[i]);
 
-		free(Input);
-		free(Output);
-		free(Temp);
+		FreeFrame(Input);
+		FreeFrame(Output);
+		FreeFrame(Temp);
 		return;
 
 	case 5:
-		// Histogram 생성
-		GenerateHistogram(Input, nHisto, hInfo.biWidth, hInfo.biHeight);
+		// 읽을 때 계산한 Histogram과 최소/최대 밝기 사용
+		GetImageStats(&Stats, Input, hInfo.biWidth, hInfo.biHeight);
 
 		// Gonzales Method로 threshold를 결정
-		bThreshold = GonzalezMethod(nHisto);
+		bThreshold = GonzalezMethodRange(Stats.nHisto, Stats.bMin, Stats.bMax);
 
 		// 이진화 진행
 		GenerateBinarization(Input, Output, hInfo.biWidth, hInfo.biHeight, bThreshold);
@@ -805,9 +8400,9 @@ void main()
 		nErr = fopen_s(&fp, "../gonzalez_binarization.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -822,45 +8417,45 @@ void main()
 		nErr = fopen_s(&fp, "../binarization.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
 		break;
 
 	case 7:
-		// Histogram 생성
-		GenerateHistogram(Input, nHisto, hInfo.biWidth, hInfo.biHeight);
+		// 읽을 때 계산한 최소/최대 밝기 사용
+		GetImageStats(&Stats, Input, hInfo.biWidth, hInfo.biHeight);
 
 		// 히스토그램 스트래칭 진행
-		HistogramStretching(Input, Output, nHisto, hInfo.biWidth, hInfo.biHeight);
+		HistogramStretchingRange(Input, Output, Stats.bMin, Stats.bMax, hInfo.biWidth, hInfo.biHeight);
 
 		nErr = fopen_s(&fp, "../stretching.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
 		break;
 
 	case 8:
-		// Histogram 생성
-		GenerateHistogram(Input, nHisto, hInfo.biWidth, hInfo.biHeight);
+		// 읽을 때 계산한 Histogram 사용
+		GetImageStats(&Stats, Input, hInfo.biWidth, hInfo.biHeight);
 
 		// 히스토그램 평활화 진행
-		HistogramEqualization(Input, Output, nHisto, hInfo.biWidth, hInfo.biHeight);
+		HistogramEqualization(Input, Output, Stats.nHisto, hInfo.biWidth, hInfo.biHeight);
 
 		nErr = fopen_s(&fp, "../equalization.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -873,9 +8468,9 @@ void main()
 		nErr = fopen_s(&fp, "../average.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -888,9 +8483,9 @@ void main()
 		nErr = fopen_s(&fp, "../guassian.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -903,9 +8498,9 @@ void main()
 		nErr = fopen_s(&fp, "../laplacian_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -918,9 +8513,9 @@ void main()
 		nErr = fopen_s(&fp, "../prewitt_x_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -933,9 +8528,9 @@ void main()
 		nErr = fopen_s(&fp, "../prewitt_y_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -959,9 +8554,9 @@ void main()
 		nErr = fopen_s(&fp, "../prewitt_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -974,9 +8569,9 @@ void main()
 		nErr = fopen_s(&fp, "../sobel_x_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -989,9 +8584,9 @@ void main()
 		nErr = fopen_s(&fp, "../sobel_y_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -1014,9 +8609,9 @@ void main()
 		nErr = fopen_s(&fp, "../sobel_edge.bmp", "wb");
 		if (NULL == fp) {
 			printf("Error : file open error = %d\n", nErr);
-			free(Input);
-			free(Output);
-			free(Temp);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
 			return;
 		}
 
@@ -1046,24 +8641,602 @@ void main()
 
 		break;
 
+	case 20:
+		// Large Kernel Convolution
+		printf("Kernel 크기(3 이상의 홀수)를 입력하세요 : ");
+		scanf_s("%d", &nKSize);
+
+		if (nKSize < 3 || 0 == nKSize % 2 || nKSize > hInfo.biWidth || nKSize > hInfo.biHeight) {
+			printf("Error : input value error = %d\n", nKSize);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		Kernel = (double*)malloc(sizeof(double) * nKSize * nKSize);
+		if (NULL == Kernel) {
+			printf("Error : memory allocation error\n");
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		GenerateGaussianKernel(Kernel, nKSize);
+
+		printf("FFT 교차점 Kernel 크기 = %d, 선택 = %s\n", FFTCrossoverKernelSize(hInfo.biWidth, hInfo.biHeight),
+			UseFFTConvolution(hInfo.biWidth, hInfo.biHeight, nKSize) ? "FFT" : "Direct");
+
+		KernelConvolution(Input, Output, hInfo.biWidth, hInfo.biHeight, Kernel, nKSize);
+		free(Kernel);
+
+		nErr = fopen_s(&fp, "../large_kernel.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 21:
+		// Canny Edge Detection
+		if (0 == CannyEdgeDetection(Input, Output, hInfo.biWidth, hInfo.biHeight, &bLowThreshold, &bHighThreshold)) {
+			printf("Error : memory allocation error\n");
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+		printf("Canny Threshold Low = %d, High = %d\n", bLowThreshold, bHighThreshold);
+
+		nErr = fopen_s(&fp, "../canny_edge.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 22:
+		// 1bpp Packed Binarization
+		printf("이진화 임계값(Threshold)를 입력하세요 : ");
+		scanf_s("%d", &nThreshold);
+
+		nOutSize = GetPackedStride(hInfo.biWidth) * hInfo.biHeight;
+		if (nOutSize > nImgSize) {
+			printf("Error : image size error = %d\n", hInfo.biWidth);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		GeneratePackedBinarization(Input, Output, hInfo.biWidth, hInfo.biHeight, (BYTE)nThreshold);
+
+		// 2색 파레트 : 0 검정, 1 흰색
+		nPalette = 2;
+		hRGB[0].rgbBlue = hRGB[0].rgbGreen = hRGB[0].rgbRed = 0;
+		hRGB[1].rgbBlue = hRGB[1].rgbGreen = hRGB[1].rgbRed = 255;
+		hInfo.biBitCount = 1;
+		hInfo.biCompression = BI_RGB;
+		hInfo.biClrUsed = hInfo.biClrImportant = 2;
+
+		nErr = fopen_s(&fp, "../binarization_1bpp.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 23:
+		// RLE8 Binarization
+		printf("이진화 임계값(Threshold)를 입력하세요 : ");
+		scanf_s("%d", &nThreshold);
+
+		nOutSize = GenerateRLEBinarization(Input, Output, hInfo.biWidth, hInfo.biHeight, (BYTE)nThreshold, nImgSize);
+
+		if (0 == nOutSize) {
+			// 압축 결과가 원본보다 크면 비압축 8bpp로 저장
+			printf("RLE 압축 효과가 없어 비압축으로 저장합니다.\n");
+			GenerateBinarization(Input, Output, hInfo.biWidth, hInfo.biHeight, (BYTE)nThreshold);
+			nOutSize = nImgSize;
+		}
+		else {
+			hInfo.biCompression = BI_RLE8;
+		}
+
+		nErr = fopen_s(&fp, "../binarization_rle.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 24:
+		// Connected Component Labeling
+		printf("연결성(4 또는 8)을 입력하세요 : ");
+		scanf_s("%d", &nConnectivity);
+
+		if (4 != nConnectivity && 8 != nConnectivity) {
+			printf("Error : input value error = %d\n", nConnectivity);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		// Gonzalez Method로 이진화한 결과를 그대로 Labeling
+		GetImageStats(&Stats, Input, hInfo.biWidth, hInfo.biHeight);
+		bThreshold = GonzalezMethodRange(Stats.nHisto, Stats.bMin, Stats.bMax);
+		GenerateBinarization(Input, Output, hInfo.biWidth, hInfo.biHeight, bThreshold);
+
+		nComponents = LabelConnectedComponents(Output, hInfo.biWidth, hInfo.biHeight, nConnectivity, NULL, &Blobs);
+		if (nComponents < 0) {
+			printf("Error : memory allocation error\n");
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		// Component 통계를 화면에 출력 (Label, 면적, Bounding Box, 무게 중심)
+		printf("Component 수 = %d\n", nComponents);
+		for (int i = 0; i < nComponents; i++)
+			printf("%d, %d, (%d, %d) - (%d, %d), (%.2f, %.2f)\n", i + 1, Blobs[i].nArea,
+				Blobs[i].nLeft, Blobs[i].nTop, Blobs[i].nRight, Blobs[i].nBottom, Blobs[i].dCenterX, Blobs[i].dCenterY);
+		free(Blobs);
+
+		nErr = fopen_s(&fp, "../blob_binarization.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 25:
+		// Strided Pooling
+		printf("Pooling 크기(2 또는 3)를 입력하세요 : ");
+		scanf_s("%d", &nPoolSize);
+		printf("Pooling 종류(1. Min, 2. Max, 3. Mean, 4. Median)를 입력하세요 : ");
+		scanf_s("%d", &nPoolType);
+
+		if ((2 != nPoolSize && 3 != nPoolSize) || nPoolType < POOL_MIN || nPoolType > POOL_MEDIAN) {
+			printf("Error : input value error = %d, %d\n", nPoolSize, nPoolType);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		if (0 == StridedPooling(Input, Output, hInfo.biWidth, hInfo.biHeight, nPoolSize, nPoolType)) {
+			printf("Error : memory allocation error\n");
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		// 출력 크기로 헤더 변경 후 BMP 행 정렬
+		hInfo.biWidth /= nPoolSize;
+		hInfo.biHeight /= nPoolSize;
+		nOutSize = PadRows(Output, hInfo.biWidth, hInfo.biHeight);
+
+		nErr = fopen_s(&fp, "../pooling.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 26:
+		// Gaussian Pyramid
+		printf("Pyramid Level 수(원본 포함, 2 이상)를 입력하세요 : ");
+		scanf_s("%d", &nLevels);
+
+		if (nLevels < 2 || 0 == BuildGaussianPyramid(Input, hInfo.biWidth, hInfo.biHeight, nLevels, &Pyramid)) {
+			printf("Error : input value error = %d\n", nLevels);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		// Level 크기를 화면에 출력하고 가장 작은 Level을 저장
+		for (int i = 0; i < Pyramid.nLevels; i++)
+			printf("Level %d : %d x %d\n", i, Pyramid.nWidth[i], Pyramid.nHeight[i]);
+
+		nLevels = Pyramid.nLevels - 1;
+		memcpy(Output, Pyramid.Level[nLevels], Pyramid.nWidth[nLevels] * Pyramid.nHeight[nLevels]);
+		hInfo.biWidth = Pyramid.nWidth[nLevels];
+		hInfo.biHeight = Pyramid.nHeight[nLevels];
+		nOutSize = PadRows(Output, hInfo.biWidth, hInfo.biHeight);
+		DestroyGaussianPyramid(&Pyramid);
+
+		nErr = fopen_s(&fp, "../pyramid.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 27:
+		// Gaussian Pyramid Reduce - Expand
+		if (0 == BuildGaussianPyramid(Input, hInfo.biWidth, hInfo.biHeight, 2, &Pyramid) || Pyramid.nLevels < 2 ||
+			0 == PyramidExpand(Pyramid.Level[1], Output, Pyramid.nWidth[1], Pyramid.nHeight[1], hInfo.biWidth, hInfo.biHeight)) {
+			printf("Error : memory allocation error\n");
+			DestroyGaussianPyramid(&Pyramid);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+		DestroyGaussianPyramid(&Pyramid);
+
+		nErr = fopen_s(&fp, "../pyramid_expand.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 28:
+		// Resize
+		printf("Resize 방식(1. Nearest, 2. Bilinear, 3. Area)을 입력하세요 : ");
+		scanf_s("%d", &nResizeMode);
+		printf("출력 가로, 세로 크기를 입력하세요 : ");
+		scanf_s("%d %d", &nOutWidth, &nOutHeight);
+
+		if (nOutWidth < 1 || nOutHeight < 1) {
+			printf("Error : input value error = %d, %d\n", nOutWidth, nOutHeight);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		// 확대하는 경우 출력 버퍼를 BMP 행 정렬 크기로 다시 할당
+		if ((nOutWidth + 3) / 4 * 4 * nOutHeight > nImgSize) {
+			BYTE* pNew = AllocFrame((nOutWidth + 3) / 4 * 4 * nOutHeight, nOutHeight);
+
+			if (NULL == pNew) {
+				printf("Error : memory allocation error\n");
+				FreeFrame(Input);
+				FreeFrame(Output);
+				FreeFrame(Temp);
+				return;
+			}
+			FreeFrame(Output);
+			Output = pNew;
+		}
+
+		if (0 == ResizeImage(Input, Output, hInfo.biWidth, hInfo.biHeight, nOutWidth, nOutHeight, nResizeMode)) {
+			printf("Error : input value error = %d\n", nResizeMode);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		hInfo.biWidth = nOutWidth;
+		hInfo.biHeight = nOutHeight;
+		nOutSize = PadRows(Output, nOutWidth, nOutHeight);
+
+		nErr = fopen_s(&fp, "../resize.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 30:
+		// Daemon Client - Pipeline
+		printf("연산 수(1 ~ %d)를 입력하세요 : ", DAEMON_MAX_PIPELINE);
+		scanf_s("%d", &Request.nOps);
+
+		if (Request.nOps < 1 || Request.nOps > DAEMON_MAX_PIPELINE) {
+			printf("Error : input value error = %d\n", Request.nOps);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		for (int i = 0; i < Request.nOps; i++) {
+			printf("%d번째 연산 번호와 인자를 입력하세요 : ", i + 1);
+			scanf_s("%d %d", &Request.nMode[i], &Request.nParam[i]);
+		}
+
+		if (0 == DaemonClientRequest(Input, Output, hInfo.biWidth, hInfo.biHeight, &Request, &nOutWidth, &nOutHeight)) {
+			printf("Error : daemon request error\n");
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		hInfo.biWidth = nOutWidth;
+		hInfo.biHeight = nOutHeight;
+		nOutSize = PadRows(Output, nOutWidth, nOutHeight);
+
+		nErr = fopen_s(&fp, "../daemon.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 31:
+		// Cached Operation
+		printf("연산 번호와 인자를 입력하세요 : ");
+		scanf_s("%d %d", &nOperation, &nParam);
+
+		if (0 == OpenResultCache(CACHE_DIR, CACHE_MAX_BYTES))
+			printf("Warning : result cache disabled (%s)\n", CACHE_DIR);
+
+		nOutWidth = hInfo.biWidth;
+		nOutHeight = hInfo.biHeight;
+		if (0 == CachedOperation(nOperation, nParam, Input, Output, Temp, &nOutWidth, &nOutHeight)) {
+			printf("Error : input value error = %d, %d\n", nOperation, nParam);
+			CloseResultCache();
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		PrintCacheStats();
+		CloseResultCache();
+
+		hInfo.biWidth = nOutWidth;
+		hInfo.biHeight = nOutHeight;
+		nOutSize = PadRows(Output, nOutWidth, nOutHeight);
+
+		nErr = fopen_s(&fp, "../cached.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 32:
+		// ROI Processing (ROI 밖은 원본 그대로, 읽지 않은 행은 0)
+		memcpy(Output, Input, nImgSize);
+
+		if (0 == ProcessRoi(nOperation, nParam, Input, Output, hInfo.biWidth, hInfo.biHeight, &Roi)) {
+			printf("Error : memory allocation error\n");
+			free(Roi.Mask);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+		free(Roi.Mask);
+
+		printf("ROI : %d rects, %lld / %d bytes read\n", Roi.nRects, llRoiRead, nImgSize);
+
+		nErr = fopen_s(&fp, "../roi.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 33:
+		// Template Matching
+		printf("Template 파일 경로를 입력하세요 : ");
+		scanf_s("%s", TemplatePath, sizeof(TemplatePath));
+		printf("방식(1. SSD, 2. NCC)과 찾을 개수(1 ~ %d)를 입력하세요 : ", MAX_MATCHES);
+		scanf_s("%d %d", &nMatchMethod, &nMatchCount);
+
+		if ((MATCH_SSD != nMatchMethod && MATCH_NCC != nMatchMethod) || nMatchCount < 1 || nMatchCount > MAX_MATCHES) {
+			printf("Error : input value error = %d, %d\n", nMatchMethod, nMatchCount);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		Template = LoadGrayImage(TemplatePath, &nTWidth, &nTHeight);
+		if (NULL == Template) {
+			printf("Error : file open error\n");
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		nMatchCount = MatchTemplate(Input, hInfo.biWidth, hInfo.biHeight, Template, nTWidth, nTHeight, nMatchMethod, nMatchCount, Matches);
+		free(Template);
+
+		if (nMatchCount < 0) {
+			printf("Error : input value error = %d, %d\n", nTWidth, nTHeight);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		// 찾은 위치에 사각형 표시
+		memcpy(Output, Input, nImgSize);
+		for (int i = 0; i < nMatchCount; i++) {
+			printf("Match %d : (%d, %d) score = %.4f\n", i + 1, Matches[i].nX, Matches[i].nY, Matches[i].dScore);
+			DrawRectangle(Output, hInfo.biWidth, hInfo.biHeight, Matches[i].nX, Matches[i].nY, nTWidth, nTHeight, 255);
+		}
+
+		nErr = fopen_s(&fp, "../match.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 34:
+		// Bilateral Filter
+		printf("반경과 밝기 sigma를 입력하세요 (반경 %d 초과는 Bilateral Grid) : ", BILATERAL_EXACT_MAX_RADIUS);
+		scanf_s("%d %lf", &nRadius, &dSigmaRange);
+
+		if (0 == BilateralFilter(Input, Output, hInfo.biWidth, hInfo.biHeight, nRadius, dSigmaRange)) {
+			printf("Error : input value error = %d, %f\n", nRadius, dSigmaRange);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		nErr = fopen_s(&fp, "../bilateral.bmp", "wb");
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
+	case 37:
+		// Distance Transform / 원판 Morphology (GenerateBinarization 결과에 적용)
+		printf("이진화 임계값, 연산(0 : 가장자리 거리 영상, 1 : 팽창, 2 : 침식), 반경을 입력하세요 : ");
+		scanf_s("%d %d %d", &nThreshold, &nEDTMode, &nRadius);
+
+		if (nThreshold < 0 || nThreshold > 255 || nEDTMode < 0 || nEDTMode > 2 || nRadius < 0) {
+			printf("Error : input value error = %d, %d, %d\n", nThreshold, nEDTMode, nRadius);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		GenerateBinarization(Input, Temp, hInfo.biWidth, hInfo.biHeight, (BYTE)nThreshold);
+
+		if (0 == nEDTMode) {
+			// 전경 픽셀마다 가장 가까운 배경까지 거리, 255로 포화하여 출력
+			Distance = (WORD*)malloc(sizeof(WORD) * nImgSize);
+
+			if (NULL == Distance || 0 == EuclideanDistanceTransform(Temp, Distance, hInfo.biWidth, hInfo.biHeight, 0, EDT_WORD)) {
+				printf("Error : memory allocation error\n");
+				free(Distance);
+				FreeFrame(Input);
+				FreeFrame(Output);
+				FreeFrame(Temp);
+				return;
+			}
+
+			for (int i = 0; i < nImgSize; i++)
+				Output[i] = Distance[i] > 255 ? 255 : (BYTE)Distance[i];
+
+			free(Distance);
+
+			nErr = fopen_s(&fp, "../distance.bmp", "wb");
+		}
+		else {
+			if (0 == DiskMorphology(Temp, Output, hInfo.biWidth, hInfo.biHeight, nRadius, 1 == nEDTMode)) {
+				printf("Error : input value error = %d\n", nRadius);
+				FreeFrame(Input);
+				FreeFrame(Output);
+				FreeFrame(Temp);
+				return;
+			}
+
+			nErr = fopen_s(&fp, "../disk_morphology.bmp", "wb");
+		}
+
+		if (NULL == fp) {
+			printf("Error : file open error = %d\n", nErr);
+			FreeFrame(Input);
+			FreeFrame(Output);
+			FreeFrame(Temp);
+			return;
+		}
+
+		break;
+
 	default:
 		printf("입력 값이 잘못되었습니다.\n");
-		free(Input);
-		free(Output);
-		free(Temp);
+		FreeFrame(Input);
+		FreeFrame(Output);
+		FreeFrame(Temp);
 		return;
 
 	}
 
+	// 연산 중 기록된 진단 값 출력
+	FlushDiag();
+
+	// 출력 형식(1bpp, RLE8 등)에 맞게 헤더의 크기 정보 갱신
+	hf.bfOffBits = sizeof(BITMAPFILEHEADER) + sizeof(BITMAPINFOHEADER) + sizeof(RGBQUAD) * nPalette;
+	hf.bfSize = hf.bfOffBits + nOutSize;
+	hInfo.biSizeImage = nOutSize;
+
 	fwrite(&hf, sizeof(BYTE), sizeof(BITMAPFILEHEADER), fp);
 	fwrite(&hInfo, sizeof(BYTE), sizeof(BITMAPINFOHEADER), fp);
-	fwrite(hRGB, sizeof(RGBQUAD), 256, fp);
-	fwrite(Output, sizeof(BYTE), nImgSize, fp);
+	fwrite(hRGB, sizeof(RGBQUAD), nPalette, fp);
+	fwrite(Output, sizeof(BYTE), nOutSize, fp);
 	fclose(fp);
 
-	free(Input);
-	free(Output);
-	free(Temp);
+#ifdef ENABLE_PROFILE
+	// Stage별 계측 결과 저장
+	nErr = fopen_s(&fp, "../profile.prom", "w");
+	if (NULL != fp) {
+		ProfileDump(fp);
+		fclose(fp);
+	}
+#endif
+
+	FreeFrame(Input);
+	FreeFrame(Output);
+	FreeFrame(Temp);
 
 	return;
 }
\ No newline at end of file